@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""
+Per-subsystem ROM/RAM footprint of a build, from the GNU ld map file (CONFIG_TELEMETRY_FOOTPRINT
+adds the matching runtime stack and buffer report).
+
+Every input section of the map is attributed to the object it came from. Application objects
+are reported per module (main, frame_pool, sample_transport, ...), everything else per Zephyr
+library (kernel, drivers__serial, libc, ...). A section counts as RAM when its output section
+lives in a writable memory region and as ROM when it lives in a read-only one; initialized data
+counts as both, since its load image is kept in ROM.
+
+    scripts/footprint.py build/zephyr/zephyr.map
+    scripts/footprint.py --app-only --sort ram build/zephyr/zephyr.map
+"""
+
+import argparse
+import collections
+import os
+import re
+import sys
+
+MEMORY_LINE = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+(\S+))?\s*$")
+OUTPUT_SECTION = re.compile(r"^([^\s*][^\s]*)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+load address 0x([0-9a-fA-F]+))?)?\s*$")
+INPUT_SECTION = re.compile(r"^ (\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*))?\s*$")
+CONTINUATION = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+load address 0x([0-9a-fA-F]+))?(?:\s+(\S.*))?\s*$")
+ARCHIVE_MEMBER = re.compile(r"^(.*)\((.*)\)$")
+
+
+class Region:
+    def __init__(self, name, origin, length, attrs):
+        self.name = name
+        self.origin = origin
+        self.length = length
+        self.writable = "w" in (attrs or "") or name.upper() in ("RAM", "SRAM", "DRAM", "IRAM")
+
+    def contains(self, address):
+        return self.origin <= address < self.origin + self.length
+
+
+def parse_regions(lines):
+    regions = []
+    in_memory = False
+    for line in lines:
+        if line.startswith("Memory Configuration"):
+            in_memory = True
+            continue
+        if line.startswith("Linker script and memory map"):
+            break
+        if not in_memory:
+            continue
+        match = MEMORY_LINE.match(line)
+        if match and match.group(1) not in ("Name", "*default*"):
+            regions.append(Region(match.group(1), int(match.group(2), 16), int(match.group(3), 16), match.group(4)))
+    return regions
+
+
+def region_of(regions, address):
+    for region in regions:
+        if region.contains(address):
+            return region
+    return None
+
+
+def subsystem_of(source):
+    """Maps an input file to a module name (application) or a library name (everything else)."""
+    match = ARCHIVE_MEMBER.match(source)
+    archive, member = match.groups() if match else ("", source)
+    obj = os.path.basename(member)
+    for suffix in (".c.obj", ".cpp.obj", ".S.obj", ".obj", ".o"):
+        if obj.endswith(suffix):
+            obj = obj[: -len(suffix)]
+            break
+    lib = os.path.basename(archive)
+    if lib == "libapp.a" or "/app.dir/" in source:
+        return "app", obj
+    if lib:
+        name = lib[3:] if lib.startswith("lib") else lib
+        return "zephyr", name[:-2] if name.endswith(".a") else name
+    return "zephyr", obj
+
+
+NON_ALLOC_PREFIXES = (".debug", ".comment", ".stab", ".ARM.attributes", ".riscv.attributes",
+                      ".gnu.attributes", ".symtab", ".strtab", ".shstrtab", ".xt.", "/DISCARD/")
+
+
+class OutputSection:
+    def __init__(self, name, regions, address, load):
+        region = region_of(regions, address)
+        load_region = region_of(regions, load) if load is not None else None
+        self.skip = name.startswith(NON_ALLOC_PREFIXES) or region is None
+        self.writable = region is not None and region.writable
+        # NOLOAD sections also print a load address; bss and noinit never occupy ROM
+        self.loaded = (self.writable and load_region is not None and not load_region.writable and
+                       "bss" not in name and "noinit" not in name)
+
+
+def parse_sections(lines, regions):
+    """Yields (group, subsystem, ram, rom) for every allocated input section with a size."""
+    output = None
+    pending = None  # ("output" | "input", name) whose address and size follow on the next line
+
+    started = False
+    for line in lines:
+        if line.startswith("Linker script and memory map"):
+            started = True
+            continue
+        if not started or not line.strip():
+            continue
+
+        if pending:
+            kind, name = pending
+            pending = None
+            match = CONTINUATION.match(line)
+            if match:
+                address, size = int(match.group(1), 16), int(match.group(2), 16)
+                if kind == "output":
+                    load = int(match.group(3), 16) if match.group(3) else None
+                    output = OutputSection(name, regions, address, load)
+                elif output and not output.skip and size and match.group(4):
+                    yield section_entry(match.group(4), size, output)
+                continue
+
+        if not line.startswith(" "):
+            match = OUTPUT_SECTION.match(line)
+            if not match:
+                continue
+            if match.group(2) is None:
+                pending = ("output", match.group(1))
+            else:
+                load = int(match.group(4), 16) if match.group(4) else None
+                output = OutputSection(match.group(1), regions, int(match.group(2), 16), load)
+            continue
+
+        if line.strip().startswith("*"):
+            continue  # fill and wildcard patterns
+        match = INPUT_SECTION.match(line)
+        if not match:
+            continue
+        if match.group(2) is None:
+            pending = ("input", match.group(1))
+            continue
+        size = int(match.group(3), 16)
+        if output and not output.skip and size:
+            yield section_entry(match.group(4), size, output)
+
+
+def section_entry(source, size, output):
+    group, subsystem = subsystem_of(source.strip())
+    ram = size if output.writable else 0
+    rom = size if (not output.writable or output.loaded) else 0
+    return group, subsystem, ram, rom
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("map", help="linker map file, usually build/zephyr/zephyr.map")
+    parser.add_argument("--app-only", action="store_true", help="only report application modules")
+    parser.add_argument("--sort", choices=("name", "rom", "ram"), default="ram")
+    args = parser.parse_args()
+
+    with open(args.map, encoding="utf-8", errors="replace") as stream:
+        lines = stream.read().splitlines()
+
+    regions = parse_regions(lines)
+    if not regions:
+        sys.exit(f"{args.map}: no memory configuration found, is this a GNU ld map file?")
+
+    totals = collections.defaultdict(lambda: [0, 0])
+    for group, subsystem, ram, rom in parse_sections(lines, regions):
+        totals[(group, subsystem)][0] += rom
+        totals[(group, subsystem)][1] += ram
+
+    key = {
+        "name": lambda item: item[0][1],
+        "rom": lambda item: -item[1][0],
+        "ram": lambda item: -item[1][1],
+    }[args.sort]
+
+    for group in ("app", "zephyr"):
+        if group == "zephyr" and args.app_only:
+            break
+        rows = sorted(((k, v) for k, v in totals.items() if k[0] == group), key=key)
+        if not rows:
+            continue
+        rom_total = sum(v[0] for _, v in rows)
+        ram_total = sum(v[1] for _, v in rows)
+        print(f"{'application' if group == 'app' else 'zephyr and libraries':<28} {'ROM':>9} {'RAM':>9}")
+        for (_, subsystem), (rom, ram) in rows:
+            print(f"  {subsystem:<26} {rom:>9} {ram:>9}")
+        print(f"  {'total':<26} {rom_total:>9} {ram_total:>9}\n")
+
+    for region in regions:
+        print(f"region {region.name:<12} {region.length:>9} bytes {'RAM' if region.writable else 'ROM'}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,288 @@
+#!/usr/bin/env python3
+"""
+Host decoder for the binary frame output (CONFIG_TELEMETRY_OUTPUT_BINARY).
+
+Reads the raw console byte stream from a file, stdin or a serial port, extracts the framed
+records (sync 0xA5, varint length, frame_codec payload, CRC-8) and prints one FRAME line per
+record in the text output format. Bytes between records, such as log output, are skipped.
+With --udp it receives the frame batches of the UDP sink (CONFIG_TELEMETRY_NET) instead, and with
+--batches it reads a file of concatenated batches, as written by the native_sim host file sink
+(CONFIG_TELEMETRY_HOST_FILE).
+Mirrors src/frame_codec.c; keep both in sync.
+
+    scripts/frame_decode.py capture.bin
+    scripts/frame_decode.py --serial /dev/ttyACM0 --baud 115200
+    scripts/frame_decode.py --udp 4242
+    scripts/frame_decode.py --batches telemetry.bin
+"""
+
+import argparse
+import socket
+import struct
+import sys
+
+RECORD_SYNC = 0xA5
+
+FLAG_KEYFRAME = 1 << 0
+FLAG_DEGRADED = 1 << 1
+FLAG_GAP = 1 << 2
+FLAG_SLOTS = 1 << 3
+FLAG_ROLLUP = 1 << 4
+FLAG_SPREAD = 1 << 5
+
+ROLLUP_LEVELS = ("1s", "10s", "60s")
+
+
+def crc8_ccitt(data, crc=0xFF):
+    """Same polynomial (0x07) and bit order as Zephyr's crc8_ccitt()."""
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+class Cursor:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            if self.pos >= len(self.data) or shift >= 64:
+                raise ValueError("truncated varint")
+            byte = self.data[self.pos]
+            self.pos += 1
+            value |= (byte & 0x7F) << shift
+            if not byte & 0x80:
+                return value
+            shift += 7
+
+    def svarint(self):
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+
+class FrameDecoder:
+    """Delta state of one record stream, the counterpart of struct frame_codec."""
+
+    def __init__(self):
+        self.ref = None
+        self.have_data = False
+        self.ts_step = 0
+
+    def decode(self, payload):
+        cur = Cursor(payload)
+        flags = cur.varint()
+        keyframe = bool(flags & FLAG_KEYFRAME)
+
+        if not keyframe and self.ref is None:
+            return None  # waiting for the first keyframe
+        if not keyframe and not flags & FLAG_GAP and not self.have_data:
+            self.ref = None  # the encoder never sends this, wait for the next keyframe
+            return None
+
+        frame = {"degraded": bool(flags & FLAG_DEGRADED), "gap": bool(flags & FLAG_GAP)}
+        if keyframe:
+            frame["frame_id"] = cur.varint()
+            frame["timestamp"] = cur.svarint()
+        else:
+            frame["frame_id"] = (self.ref["frame_id"] + 1 + cur.svarint()) & 0xFFFFFFFF
+            frame["timestamp"] = self.ref["timestamp"] + self.ts_step + cur.svarint()
+        frame["slot_count"] = cur.varint() if flags & FLAG_SLOTS else 1
+
+        if frame["gap"]:
+            frame["channels"] = []
+        else:
+            fields = 7 if flags & FLAG_SPREAD else 4  # latest/avg/min/max[/stddev/p50/p95]
+            if keyframe:
+                frame["uptime"] = cur.varint()
+                count = cur.varint()
+                base = [(0,) * fields] * count
+            else:
+                frame["uptime"] = (self.ref["uptime"] + cur.svarint()) & 0xFFFFFFFF
+                base = [(ref + (0, 0, 0))[:fields] for ref in self.ref["channels"]]
+            frame["channels"] = [tuple(b + cur.svarint() for b in ref) for ref in base]
+            if flags & FLAG_ROLLUP:
+                mask = cur.varint()
+                for level, name in enumerate(ROLLUP_LEVELS):
+                    if mask & (1 << level):
+                        start = frame["timestamp"] - cur.varint()
+                        total, low, high, count = cur.svarint(), cur.svarint(), cur.svarint(), cur.varint()
+                        frame.setdefault("rollups", []).append((name, start, total, low, high, count))
+
+        self.ts_step = frame["timestamp"] - self.ref["timestamp"] if self.ref and not keyframe else 0
+        if frame["gap"]:
+            # Gap records keep the data fields of the previous frame as reference
+            base = self.ref or {"uptime": 0, "channels": []}
+            self.ref = dict(base, frame_id=frame["frame_id"], timestamp=frame["timestamp"])
+            # Starting at a gap keyframe leaves no data fields for the next delta
+            self.have_data = self.have_data and not keyframe
+        else:
+            self.ref = frame
+            self.have_data = True
+        return frame
+
+
+def format_frame(frame):
+    if frame["gap"]:
+        last = frame["frame_id"] + frame["slot_count"] - 1
+        return f"GAP {frame['frame_id']}-{last} | ts={frame['timestamp']} | slots={frame['slot_count']}"
+
+    channels = frame["channels"]
+    latest, avg, low, high = channels[0][:4] if channels else (-1, -1, -1, -1)
+    line = (f"FRAME {frame['frame_id']} | ts={frame['timestamp']} | up={frame['uptime']} | "
+            f"sensor={latest} | avg={max(avg, 0)} | min={low} | max={high} | degraded={int(frame['degraded'])}")
+    if frame["slot_count"] > 1:
+        line += f" | slots={frame['slot_count']}"
+    if channels and len(channels[0]) == 7:
+        line += " | sd={} | p50={} | p95={}".format(*channels[0][4:])
+    for index, stats in enumerate(channels[1:], start=1):
+        line += f" | ch{index}=" + "/".join(str(v) for v in stats)
+    for name, start, total, low, high, count in frame.get("rollups", []):
+        if count:
+            # C integer division truncates towards zero
+            avg = abs(total) // count * (1 if total >= 0 else -1)
+            line += f"\nROLLUP {name} | start={start} | avg={avg} | min={low} | max={high} | n={count}"
+    return line
+
+
+def batch_records(datagram):
+    """Yields the record payloads of one frame batch (header, then length-prefixed records)."""
+    first_id, last_id, count, used = struct.unpack_from("<IIHH", datagram)
+    cur = Cursor(datagram[:used])
+    cur.pos = 12
+    for _ in range(count):
+        length = cur.varint()
+        yield datagram[cur.pos:cur.pos + length]
+        cur.pos += length
+
+
+def udp_datagrams(port):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("", port))
+    while True:
+        datagram, _ = sock.recvfrom(2048)
+        yield datagram
+
+
+def file_batches(stream):
+    """Yields the batches of a file of concatenated frame batches; each header holds its length."""
+    data = stream.read()
+    pos = 0
+    while pos + 12 <= len(data):
+        used = struct.unpack_from("<H", data, pos + 10)[0]
+        if used < 12 or pos + used > len(data):
+            print(f"# truncated batch at offset {pos}", file=sys.stderr)
+            return
+        yield data[pos:pos + used]
+        pos += used
+
+
+def records(stream):
+    """Yields (payload, record_size) for every record with a valid CRC, None for a CRC error."""
+    buf = bytearray()
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            return
+        buf += chunk
+        while True:
+            start = buf.find(RECORD_SYNC)
+            if start < 0:
+                buf.clear()
+                break
+            del buf[:start]
+            if len(buf) < 3:
+                break
+            length = buf[1] & 0x7F
+            header = 2
+            if buf[1] & 0x80:
+                length |= buf[2] << 7
+                header = 3
+            size = header + length + 1
+            if len(buf) < size:
+                break
+            payload = bytes(buf[header:header + length])
+            if crc8_ccitt(payload) != buf[size - 1]:
+                del buf[:1]  # false sync inside text, rescan
+                yield None
+                continue
+            del buf[:size]
+            yield payload, size
+
+
+def open_input(args):
+    if args.serial:
+        import serial  # pyserial
+
+        return serial.Serial(args.serial, args.baud)
+    if args.input == "-":
+        return sys.stdin.buffer
+    return open(args.input, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", nargs="?", default="-", help="capture file, - for stdin")
+    parser.add_argument("--serial", help="read from this serial port instead (needs pyserial)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--udp", type=int, metavar="PORT", help="receive UDP frame batches on this port")
+    parser.add_argument("--batches", action="store_true", help="input is a file of frame batches")
+    parser.add_argument("--stats", action="store_true", help="print byte statistics at the end")
+    args = parser.parse_args()
+
+    decoder = FrameDecoder()
+    frames = 0
+    record_bytes = 0
+    crc_errors = 0
+
+    if args.udp or args.batches:
+        source = udp_datagrams(args.udp) if args.udp else file_batches(open_input(args))
+        try:
+            for datagram in source:
+                # Every batch starts with a keyframe and decodes on its own
+                decoder = FrameDecoder()
+                for payload in batch_records(datagram):
+                    frame = decoder.decode(payload)
+                    if frame is not None:
+                        frames += 1
+                        print(format_frame(frame), flush=True)
+                record_bytes += len(datagram)
+        except KeyboardInterrupt:
+            pass
+        if args.stats and frames:
+            print(f"# {frames} frames, {record_bytes} bytes, {record_bytes / frames:.1f} bytes/frame",
+                  file=sys.stderr)
+        return
+
+    try:
+        for record in records(open_input(args)):
+            if record is None:
+                # A false sync or a corrupt record; a lost delta would shift every following value
+                crc_errors += 1
+                decoder = FrameDecoder()
+                continue
+            payload, size = record
+            try:
+                frame = decoder.decode(payload)
+            except ValueError:
+                decoder = FrameDecoder()
+                continue
+            if frame is None:
+                continue
+            frames += 1
+            record_bytes += size
+            print(format_frame(frame), flush=True)
+    except KeyboardInterrupt:
+        pass
+
+    if args.stats and frames:
+        print(f"# {frames} frames, {record_bytes} bytes, {record_bytes / frames:.1f} bytes/frame, "
+              f"{crc_errors} CRC errors", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
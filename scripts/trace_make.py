@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""
+Builds a sensor trace for the trace replay source (CONFIG_TELEMETRY_REPLAY).
+
+The input is CSV with one sample per line: time in ms from the start of the trace, channel index
+and value. A header line and lines starting with # are skipped. With a single column, the
+values are taken as channel 0 samples every --rate-ms. --sine generates a synthetic trace instead,
+the same 0-100 waveform as the built-in sensor, for throughput runs without a recording.
+
+Output format, all little endian (see src/trace_replay.h):
+    header  8 bytes: magic "TRC1", record count
+    record 10 bytes: time offset in ms (u32), channel index (u16), value (s32)
+
+    scripts/trace_make.py recording.csv trace.bin
+    scripts/trace_make.py --sine 3600 trace.bin
+"""
+
+import argparse
+import csv
+import math
+import random
+import struct
+import sys
+
+MAGIC = b"TRC1"
+
+
+def csv_samples(path, rate_ms):
+    index = 0  # accepted single column samples, so skipped lines leave no gap
+    with open(path, newline="", encoding="utf-8") as stream:
+        reader = csv.reader(stream)
+        for row in reader:
+            if not row or row[0].lstrip().startswith("#"):
+                continue
+            try:
+                values = [int(float(field)) for field in row]
+            except ValueError:
+                continue  # header line
+            if len(values) == 1:
+                yield index * rate_ms, 0, values[0]
+                index += 1
+            elif len(values) == 2:
+                sys.exit(f"{path}:{reader.line_num}: expected time_ms,channel,value or a single value")
+            else:
+                yield values[0], values[1], values[2]
+
+
+def sine_samples(seconds, rate_ms, seed):
+    rng = random.Random(seed)
+    for index in range(seconds * 1000 // rate_ms):
+        value = int(50.0 * math.sin(index * 2.0 * math.pi / 100.0)) + 50 + rng.randint(-10, 10)
+        yield index * rate_ms, 0, min(max(value, 0), 100)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", nargs="?", help="CSV recording (time_ms,channel,value or one value per line)")
+    parser.add_argument("output", help="trace file to write")
+    parser.add_argument("--rate-ms", type=int, default=50, help="sample period of single column input and of --sine")
+    parser.add_argument("--sine", type=int, metavar="SECONDS", help="generate a synthetic trace of this length")
+    parser.add_argument("--seed", type=int, default=1, help="noise seed of --sine")
+    args = parser.parse_args()
+
+    if args.sine:
+        samples = list(sine_samples(args.sine, args.rate_ms, args.seed))
+    elif args.input:
+        samples = list(csv_samples(args.input, args.rate_ms))
+    else:
+        sys.exit("either an input CSV or --sine is required")
+
+    last = 0
+    for time_ms, channel, value in samples:
+        if time_ms < last:
+            sys.exit(f"samples must be in time order ({time_ms} ms after {last} ms)")
+        last = time_ms
+
+    with open(args.output, "wb") as out:
+        out.write(MAGIC + struct.pack("<I", len(samples)))
+        for time_ms, channel, value in samples:
+            out.write(struct.pack("<IHi", time_ms, channel, value))
+
+    print(f"{args.output}: {len(samples)} records, {last / 1000:.1f} s")
+
+
+if __name__ == "__main__":
+    main()
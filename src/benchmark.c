@@ -0,0 +1,467 @@
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/atomic.h>
+#if defined(CONFIG_ZBUS)
+#include <zephyr/zbus/zbus.h>
+#endif
+
+#include "benchmark.h"
+#include "telemetry.h"
+#include "sample_transport.h"
+#include "spsc_ring.h"
+#include "load_spike.h"
+#include "queue_stats.h"
+#include "frame_rate.h"
+#include "cpu_affinity.h"
+#include "sched_edf.h"
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+#include "latency_stats.h"
+#endif
+
+/* ========== Constants ========== */
+
+#define BENCH_BATCH                 SENSOR_QUEUE_SIZE  /* samples queued per simulated frame */
+#define BENCH_ROUNDS                512
+#define BENCH_FRAMES                CONFIG_TELEMETRY_BENCHMARK_FRAMES
+
+/* ========== Global Variables ========== */
+
+/* Private instances so the benchmark never touches the live transports */
+K_MSGQ_DEFINE(bench_msgq, sizeof(struct sensor_data), BENCH_BATCH, __alignof__(struct sensor_data));
+SPSC_RING_DEFINE(bench_ring, struct sensor_data, SENSOR_RING_SIZE);
+
+/* Sample record before compact stamps: 64-bit stamp, 8-byte alignment and tail padding */
+struct bench_wide_sample {
+    int64_t  timestamp_us;
+    int      sensor_value;
+    uint16_t channel;
+};
+
+K_MSGQ_DEFINE(bench_wide_msgq, sizeof(struct bench_wide_sample), BENCH_BATCH, __alignof__(struct bench_wide_sample));
+SPSC_RING_DEFINE(bench_wide_ring, struct bench_wide_sample, SENSOR_RING_SIZE);
+
+#if defined(CONFIG_ZBUS)
+/* Same shape as sensor_chan: one listener forwarding into a ring */
+static void bench_listener_cb(const struct zbus_channel *chan)
+{
+    (void)spsc_ring_put(&bench_ring, zbus_chan_const_msg(chan));
+}
+
+ZBUS_LISTENER_DEFINE(bench_listener, bench_listener_cb);
+ZBUS_CHAN_DEFINE(bench_chan, struct sensor_data, NULL, NULL, ZBUS_OBSERVERS(bench_listener), ZBUS_MSG_INIT(0));
+#endif
+
+/* Frame hook state, written by the aggregator while a profile run is recording */
+static uint32_t bench_jitter_cycles[BENCH_FRAMES];
+static uint32_t bench_frames;
+static uint32_t bench_missed;
+static uint32_t bench_last_wake;
+static atomic_t bench_recording;
+K_SEM_DEFINE(bench_done, 0, 1);
+
+struct deadline_result {
+    uint32_t p99_us;
+    uint32_t max_us;
+    uint32_t missed;
+    int      cpu_pct;
+    uint32_t jobs;          /* data path jobs released during the run, CONFIG_TELEMETRY_EDF */
+    uint32_t job_misses;    /* of which finished after their deadline */
+};
+
+struct transport_result {
+    uint64_t put_cycles;
+    uint64_t get_cycles;
+    uint32_t samples;
+};
+
+struct layout_result {
+    uint64_t msgq_cycles;
+    uint64_t spsc_cycles;
+    uint32_t samples;
+};
+
+/* ========== Transport Benchmark ========== */
+
+/*
+ * Each round mimics one frame of the real data path: the producer queues BENCH_BATCH samples
+ * one by one and the aggregator then drains everything that is pending.
+ */
+static void bench_transport_msgq(struct transport_result *res)
+{
+    struct sensor_data sample = {0};
+    struct sensor_data batch[BENCH_BATCH];
+    uint32_t start;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        start = k_cycle_get_32();
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            sample.sensor_value = i;
+            (void)k_msgq_put(&bench_msgq, &sample, K_NO_WAIT);
+        }
+        res->put_cycles += k_cycle_get_32() - start;
+
+        start = k_cycle_get_32();
+        uint32_t count = 0;
+        while (count < BENCH_BATCH && k_msgq_get(&bench_msgq, &batch[count], K_NO_WAIT) == 0) {
+            count++;
+        }
+        res->get_cycles += k_cycle_get_32() - start;
+        res->samples += count;
+    }
+}
+
+static void bench_transport_spsc(struct transport_result *res)
+{
+    struct sensor_data sample = {0};
+    struct sensor_data batch[BENCH_BATCH];
+    uint32_t start;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        start = k_cycle_get_32();
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            sample.sensor_value = i;
+            (void)spsc_ring_put(&bench_ring, &sample);
+        }
+        res->put_cycles += k_cycle_get_32() - start;
+
+        start = k_cycle_get_32();
+        uint32_t count = spsc_ring_drain(&bench_ring, batch, BENCH_BATCH);
+        res->get_cycles += k_cycle_get_32() - start;
+        res->samples += count;
+    }
+}
+
+#if defined(CONFIG_ZBUS)
+/*
+ * put_cycles is the publish latency seen by the producer: channel lock, message copy and the
+ * synchronous listener's ring put. The drain side is the same SPSC bulk copy as above.
+ */
+static void bench_transport_zbus(struct transport_result *res)
+{
+    struct sensor_data sample = {0};
+    struct sensor_data batch[BENCH_BATCH];
+    uint32_t start;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        start = k_cycle_get_32();
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            sample.sensor_value = i;
+            (void)zbus_chan_pub(&bench_chan, &sample, K_NO_WAIT);
+        }
+        res->put_cycles += k_cycle_get_32() - start;
+
+        start = k_cycle_get_32();
+        uint32_t count = spsc_ring_drain(&bench_ring, batch, BENCH_BATCH);
+        res->get_cycles += k_cycle_get_32() - start;
+        res->samples += count;
+    }
+}
+#endif
+
+static void report_transport(const char *path, const struct transport_result *res)
+{
+    uint32_t samples = MAX(res->samples, 1U);
+
+    printk("BENCH {\"bench\":\"transport\",\"path\":\"%s\",\"samples\":%u,"
+           "\"put_cycles_per_sample\":%u,\"get_cycles_per_sample\":%u,\"cycles_per_sample\":%u}\n",
+           path, res->samples,
+           (uint32_t)(res->put_cycles / samples),
+           (uint32_t)(res->get_cycles / samples),
+           (uint32_t)((res->put_cycles + res->get_cycles) / samples));
+}
+
+static void bench_transport(void)
+{
+    struct transport_result msgq_result = {0};
+    struct transport_result spsc_result = {0};
+
+    bench_transport_msgq(&msgq_result);
+    bench_transport_spsc(&spsc_result);
+
+    report_transport("msgq", &msgq_result);
+    report_transport("spsc", &spsc_result);
+
+#if defined(CONFIG_ZBUS)
+    struct transport_result zbus_result = {0};
+
+    bench_transport_zbus(&zbus_result);
+    report_transport("zbus", &zbus_result);
+#endif
+}
+
+/* ========== Layout Benchmark ========== */
+
+/*
+ * Copy cost of one record layout through both transports: BENCH_BATCH puts followed by a full drain
+ * per round, put and get counted together. batch holds BENCH_BATCH records of the layout.
+ */
+static void bench_layout(struct k_msgq *msgq, struct spsc_ring *ring, const void *sample, void *batch,
+                         size_t size, struct layout_result *res)
+{
+    uint32_t start;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        start = k_cycle_get_32();
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            (void)k_msgq_put(msgq, sample, K_NO_WAIT);
+        }
+        uint32_t count = 0;
+        while (count < BENCH_BATCH && k_msgq_get(msgq, (uint8_t *)batch + count * size, K_NO_WAIT) == 0) {
+            count++;
+        }
+        res->msgq_cycles += k_cycle_get_32() - start;
+
+        start = k_cycle_get_32();
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            (void)spsc_ring_put(ring, sample);
+        }
+        count = spsc_ring_drain(ring, batch, BENCH_BATCH);
+        res->spsc_cycles += k_cycle_get_32() - start;
+        res->samples += count;
+    }
+}
+
+static void report_layout(const char *record, size_t bytes, const struct layout_result *res)
+{
+    uint32_t samples = MAX(res->samples, 1U);
+
+    printk("BENCH {\"bench\":\"layout\",\"record\":\"%s\",\"bytes\":%u,"
+           "\"msgq_cycles_per_sample\":%u,\"spsc_cycles_per_sample\":%u}\n",
+           record, (uint32_t)bytes,
+           (uint32_t)(res->msgq_cycles / samples),
+           (uint32_t)(res->spsc_cycles / samples));
+}
+
+/* The wide record is the baseline, "sensor_data" is the record of this build */
+static void bench_layouts(void)
+{
+    struct bench_wide_sample wide_sample = {0};
+    struct bench_wide_sample wide_batch[BENCH_BATCH];
+    struct sensor_data sample = {0};
+    struct sensor_data batch[BENCH_BATCH];
+    struct layout_result wide_result = {0};
+    struct layout_result result = {0};
+
+    bench_layout(&bench_wide_msgq, &bench_wide_ring, &wide_sample, wide_batch, sizeof(wide_sample), &wide_result);
+    bench_layout(&bench_msgq, &bench_ring, &sample, batch, sizeof(sample), &result);
+
+    report_layout("wide", sizeof(struct bench_wide_sample), &wide_result);
+    report_layout("sensor_data", sizeof(struct sensor_data), &result);
+    printk("BENCH {\"bench\":\"layout\",\"record\":\"frame\",\"bytes\":%u,\"cache_line\":%u}\n",
+           (uint32_t)sizeof(struct telemetry_frame), (uint32_t)TELEMETRY_CACHE_LINE);
+}
+
+/* ========== Deadline Benchmark ========== */
+
+void benchmark_frame_hook(uint32_t wake_cycles, bool deadline_met)
+{
+    uint32_t period = wake_cycles - bench_last_wake;
+    uint32_t nominal = k_ms_to_cyc_ceil32(frame_rate_period_ms());
+
+    bench_last_wake = wake_cycles;
+    if (!atomic_get(&bench_recording)) {
+        return;
+    }
+
+    bench_jitter_cycles[bench_frames++] = period > nominal ? period - nominal : nominal - period;
+    if (!deadline_met) {
+        bench_missed++;
+    }
+
+    if (bench_frames == BENCH_FRAMES) {
+        atomic_set(&bench_recording, 0);
+        k_sem_give(&bench_done);
+    }
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of a sorted array, in microseconds */
+static uint32_t percentile_us(const uint32_t *sorted, uint32_t count, uint32_t pct)
+{
+    uint32_t rank = (count * pct + 99) / 100;
+
+    return k_cyc_to_us_floor32(sorted[MAX(rank, 1U) - 1]);
+}
+
+static void run_profile(const struct load_profile *profile, struct deadline_result *res)
+{
+    uint32_t drops_before[TELEMETRY_QUEUE_COUNT];
+    int cpu_pct = -1;
+
+    load_spike_select_profile(profile);
+    k_sleep(K_MSEC(TELEMETRY_FRAME_RATE_MS));  /* let the generator pick up the profile */
+
+    for (int q = 0; q < TELEMETRY_QUEUE_COUNT; q++) {
+        drops_before[q] = queue_stats_drops(q);
+    }
+    res->jobs = 0;
+    res->job_misses = 0;
+#if defined(CONFIG_TELEMETRY_EDF)
+    for (int a = 0; a < EDF_ACTIVITY_COUNT; a++) {
+        res->jobs -= edf_jobs(a);
+        res->job_misses -= edf_misses(a);
+    }
+#endif
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+    latency_reset();    /* the histograms count since boot, each run starts them afresh */
+#endif
+#if defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+    k_thread_runtime_stats_t cpu_before;
+    k_thread_runtime_stats_t cpu_after;
+
+    k_thread_runtime_stats_all_get(&cpu_before);
+#endif
+
+    bench_frames = 0;
+    bench_missed = 0;
+    k_sem_reset(&bench_done);
+    atomic_set(&bench_recording, 1);
+
+    k_sem_take(&bench_done, K_FOREVER);
+
+#if defined(CONFIG_TELEMETRY_EDF)
+    for (int a = 0; a < EDF_ACTIVITY_COUNT; a++) {
+        res->jobs += edf_jobs(a);
+        res->job_misses += edf_misses(a);
+    }
+#endif
+#if defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+    k_thread_runtime_stats_all_get(&cpu_after);
+
+    uint64_t busy = cpu_after.total_cycles - cpu_before.total_cycles;
+    uint64_t elapsed = cpu_after.execution_cycles - cpu_before.execution_cycles;
+
+    if (elapsed > 0) {
+        cpu_pct = (int)((busy * 100) / elapsed);
+    }
+#endif
+
+    qsort(bench_jitter_cycles, bench_frames, sizeof(bench_jitter_cycles[0]), compare_u32);
+
+    printk("BENCH {\"bench\":\"deadline\",\"profile\":\"%s\",\"seed\":%u,\"priority\":%d,\"frames\":%u,"
+           "\"jitter_us\":{\"p50\":%u,\"p90\":%u,\"p99\":%u,\"max\":%u},\"missed\":%u,\"drops\":{",
+           profile->name, profile->seed, profile->priority, bench_frames,
+           percentile_us(bench_jitter_cycles, bench_frames, 50),
+           percentile_us(bench_jitter_cycles, bench_frames, 90),
+           percentile_us(bench_jitter_cycles, bench_frames, 99),
+           k_cyc_to_us_floor32(bench_jitter_cycles[bench_frames - 1]),
+           bench_missed);
+    for (int q = 0; q < TELEMETRY_QUEUE_COUNT; q++) {
+        printk("%s\"%s\":%u", q == 0 ? "" : ",", queue_stats_name(q),
+               queue_stats_drops(q) - drops_before[q]);
+    }
+    printk("},\"cpu_pct\":%d", cpu_pct);
+#if defined(CONFIG_TELEMETRY_CPU_PINNING)
+    printk(",\"placement\":\"%s\"", cpu_affinity_pinned() ? "pinned" : "floating");
+#endif
+#if defined(CONFIG_TELEMETRY_EDF)
+    printk(",\"sched\":\"%s\",\"jobs\":%u,\"job_misses\":%u", edf_enabled() ? "edf" : "fixed",
+           res->jobs, res->job_misses);
+#endif
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+    struct latency_summary latency;
+    bool first = true;
+
+    printk(",\"latency_us\":{");
+    for (int stage = 0; stage < LATENCY_STAGE_COUNT; stage++) {
+        latency_summarize(stage, &latency);
+        if (latency.count == 0) {
+            continue;
+        }
+        printk("%s\"%s\":{\"p50\":%u,\"p99\":%u,\"max\":%u}", first ? "" : ",", latency_stage_name(stage),
+               latency.p50_us, latency.p99_us, latency.max_us);
+        first = false;
+    }
+    printk("}");
+#endif
+    printk("}\n");
+
+    res->p99_us = percentile_us(bench_jitter_cycles, bench_frames, 99);
+    res->max_us = k_cyc_to_us_floor32(bench_jitter_cycles[bench_frames - 1]);
+    res->missed = bench_missed;
+    res->cpu_pct = cpu_pct;
+}
+
+#if defined(CONFIG_TELEMETRY_CPU_PINNING)
+/* Same profile floating and pinned, one comparison line per profile */
+static void run_placements(const struct load_profile *profile)
+{
+    struct deadline_result floating;
+    struct deadline_result pinned;
+
+    (void)cpu_affinity_set_pinned(false);
+    run_profile(profile, &floating);
+    (void)cpu_affinity_set_pinned(true);
+    run_profile(profile, &pinned);
+
+    printk("BENCH {\"bench\":\"placement\",\"profile\":\"%s\","
+           "\"floating\":{\"p99_us\":%u,\"max_us\":%u,\"missed\":%u},"
+           "\"pinned\":{\"p99_us\":%u,\"max_us\":%u,\"missed\":%u}}\n",
+           profile->name, floating.p99_us, floating.max_us, floating.missed,
+           pinned.p99_us, pinned.max_us, pinned.missed);
+}
+#endif
+
+#if defined(CONFIG_TELEMETRY_EDF)
+/* Same profile with the fixed-priority baseline and with EDF, one comparison line per profile */
+static void run_schedules(const struct load_profile *profile)
+{
+    struct deadline_result fixed;
+    struct deadline_result edf;
+
+    edf_set_enabled(false);
+    run_profile(profile, &fixed);
+    edf_set_enabled(true);
+    run_profile(profile, &edf);
+
+    printk("BENCH {\"bench\":\"sched\",\"profile\":\"%s\","
+           "\"fixed\":{\"cpu_pct\":%d,\"missed\":%u,\"jobs\":%u,\"job_misses\":%u,\"p99_us\":%u},"
+           "\"edf\":{\"cpu_pct\":%d,\"missed\":%u,\"jobs\":%u,\"job_misses\":%u,\"p99_us\":%u}}\n",
+           profile->name,
+           fixed.cpu_pct, fixed.missed, fixed.jobs, fixed.job_misses, fixed.p99_us,
+           edf.cpu_pct, edf.missed, edf.jobs, edf.job_misses, edf.p99_us);
+}
+#endif
+
+void benchmark_run_profiles(void)
+{
+    /* Every profile of the shared load profile table, in table order */
+    for (uint32_t i = 0; i < load_profile_count; i++) {
+#if defined(CONFIG_TELEMETRY_CPU_PINNING)
+        run_placements(&load_profiles[i]);
+#endif
+#if defined(CONFIG_TELEMETRY_EDF)
+        run_schedules(&load_profiles[i]);
+#endif
+#if !defined(CONFIG_TELEMETRY_CPU_PINNING) && !defined(CONFIG_TELEMETRY_EDF)
+        struct deadline_result res;
+
+        run_profile(&load_profiles[i], &res);
+#endif
+    }
+
+    load_spike_select_profile(load_profile_boot());
+    printk("BENCH {\"bench\":\"done\"}\n");
+}
+
+/* ========== Entry Points ========== */
+
+/* 
+ * Runs from main before the application threads are created, so the measurements only see
+ * interrupt noise and not the data path itself.
+ */
+void benchmark_run_micro(void)
+{
+    printk("BENCH {\"bench\":\"info\",\"cycles_per_sec\":%u}\n", sys_clock_hw_cycles_per_sec());
+
+    bench_transport();
+    bench_layouts();
+}
@@ -0,0 +1,33 @@
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Benchmark suite, built with CONFIG_TELEMETRY_BENCHMARK.
+ *
+ * Results are printed as one "BENCH {...}" JSON object per line so runs can be collected and
+ * compared across commits with a simple grep.
+ */
+
+/*
+ * Micro benchmarks of isolated building blocks: transport cost per sample, and bytes and copy cost
+ * per sample of the sample record against the wide 64-bit stamp layout. Run before the application
+ * threads are created.
+ */
+void benchmark_run_micro(void);
+
+/*
+ * Deadline benchmark: runs the live aggregator for CONFIG_TELEMETRY_BENCHMARK_FRAMES frames under
+ * each seeded load profile and reports frame-period jitter, missed deadlines, drops and CPU load.
+ * With CONFIG_TELEMETRY_CPU_PINNING every profile runs floating and then pinned, followed by a
+ * "placement" line comparing the two. With CONFIG_TELEMETRY_EDF every profile runs with fixed priorities
+ * and then with EDF, followed by a "sched" line comparing utilization and misses. Blocks the calling thread until all profiles are done.
+ */
+void benchmark_run_profiles(void);
+
+/* Called by the aggregator right after every frame wakeup */
+void benchmark_frame_hook(uint32_t wake_cycles, bool deadline_met);
+
+#endif /* BENCHMARK_H_ */
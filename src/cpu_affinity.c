@@ -0,0 +1,133 @@
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "cpu_affinity.h"
+
+LOG_MODULE_DECLARE(telemetry);
+
+/* ========== Constants ========== */
+
+#define DATA_PATH_CPU               CONFIG_TELEMETRY_DATA_PATH_CPU
+#define PLACE_RETRY_DELAY           K_MSEC(1)
+#define PLACE_RETRIES               500  /* longer than the longest load burst of the profile table */
+
+BUILD_ASSERT(DATA_PATH_CPU < CONFIG_MP_MAX_NUM_CPUS, "CONFIG_TELEMETRY_DATA_PATH_CPU is not a CPU");
+
+/* ========== Global Variables ========== */
+
+struct placed_thread {
+    struct k_thread *thread;
+    enum cpu_role role;
+    uint32_t index;
+};
+
+/* Main thread only */
+static struct placed_thread placed[CPU_AFFINITY_MAX_THREADS];
+static uint32_t placed_count;
+static bool placement_pinned = true;
+
+/* ========== Placement Functions ========== */
+
+static uint32_t role_mask(const struct placed_thread *pt, bool pinned)
+{
+    uint32_t cpus = arch_num_cpus();
+    uint32_t all = BIT_MASK(cpus);
+    uint32_t data = BIT(DATA_PATH_CPU);
+    uint32_t others = all & ~data;
+
+    switch (pt->role) {
+    case CPU_ROLE_AGGREGATOR:
+        return pinned ? data : all;
+    case CPU_ROLE_PRODUCER:
+        return pinned && IS_ENABLED(CONFIG_TELEMETRY_CPU_PIN_PRODUCER) ? data : all;
+    case CPU_ROLE_LOAD: {
+        uint32_t own = BIT(pt->index % cpus);
+
+        /* The load of the data path CPU moves to the others when pinned */
+        return pinned && own == data ? others : own;
+    }
+    case CPU_ROLE_SINK:
+    default:
+        return pinned ? others : all;
+    }
+}
+
+/* Grows the mask before shrinking it, so a thread that turns runnable half way never has an empty mask */
+static int apply_mask(struct k_thread *thread, uint32_t mask)
+{
+    uint32_t cpus = arch_num_cpus();
+    int rc;
+
+    for (uint32_t cpu = 0; cpu < cpus; cpu++) {
+        if ((mask & BIT(cpu)) != 0) {
+            rc = k_thread_cpu_mask_enable(thread, (int)cpu);
+            if (rc != 0) {
+                return rc;
+            }
+        }
+    }
+    for (uint32_t cpu = 0; cpu < cpus; cpu++) {
+        if ((mask & BIT(cpu)) == 0) {
+            rc = k_thread_cpu_mask_disable(thread, (int)cpu);
+            if (rc != 0) {
+                return rc;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Retries while the thread is runnable; a blocked or not yet started thread takes the mask at once */
+static int place_thread(const struct placed_thread *pt, bool pinned)
+{
+    uint32_t mask = role_mask(pt, pinned);
+
+    for (int retry = 0; retry < PLACE_RETRIES; retry++) {
+        if (apply_mask(pt->thread, mask) == 0) {
+            return 0;
+        }
+        k_sleep(PLACE_RETRY_DELAY);
+    }
+
+    LOG_WRN("Thread %p stayed runnable, CPU mask 0x%x not applied", (void *)pt->thread, mask);
+    return -EBUSY;
+}
+
+/* ========== Public API ========== */
+
+void cpu_affinity_register(struct k_thread *thread, enum cpu_role role, uint32_t index)
+{
+    if (placed_count == CPU_AFFINITY_MAX_THREADS) {
+        LOG_WRN("CPU placement table full");
+        return;
+    }
+
+    struct placed_thread *pt = &placed[placed_count++];
+
+    pt->thread = thread;
+    pt->role = role;
+    pt->index = index;
+    (void)place_thread(pt, placement_pinned);
+}
+
+int cpu_affinity_set_pinned(bool pinned)
+{
+    int rc = 0;
+
+    placement_pinned = pinned;
+    for (uint32_t i = 0; i < placed_count; i++) {
+        if (place_thread(&placed[i], pinned) != 0) {
+            rc = -EBUSY;
+        }
+    }
+
+    LOG_INF("CPU placement %s, data path on CPU %d", pinned ? "pinned" : "floating", DATA_PATH_CPU);
+    return rc;
+}
+
+bool cpu_affinity_pinned(void)
+{
+    return placement_pinned;
+}
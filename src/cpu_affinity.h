@@ -0,0 +1,55 @@
+#ifndef CPU_AFFINITY_H_
+#define CPU_AFFINITY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <zephyr/kernel.h>
+
+/*
+ * SMP thread placement (CONFIG_TELEMETRY_CPU_PINNING).
+ *
+ * Every application thread is registered with its role at creation. Pinned placement isolates the
+ * aggregator on the data path CPU (CONFIG_TELEMETRY_DATA_PATH_CPU), together with the producer when
+ * CONFIG_TELEMETRY_CPU_PIN_PRODUCER is set, and confines the load and sink threads to the other CPUs.
+ * Floating placement lets the data path and the sinks run anywhere and keeps one load thread per CPU,
+ * so a load spike can land on the aggregator's core.
+ *
+ * The kernel only changes the CPU mask of a thread that is not runnable. A mask is therefore grown
+ * before it is shrunk, so it is never empty, and a thread that is running is retried for a while.
+ */
+
+enum cpu_role {
+    CPU_ROLE_AGGREGATOR,
+    CPU_ROLE_PRODUCER,      /* producer and trace replay */
+    CPU_ROLE_LOAD,          /* index is the load thread number */
+    CPU_ROLE_SINK,          /* output, store, net and host file threads */
+};
+
+#if defined(CONFIG_TELEMETRY_CPU_PINNING)
+
+/* Number of threads tracked; threads beyond this keep the kernel's default mask */
+#define CPU_AFFINITY_MAX_THREADS    16
+
+/* Registers a thread and applies the current placement. Call before k_thread_start(). */
+void cpu_affinity_register(struct k_thread *thread, enum cpu_role role, uint32_t index);
+
+/*
+ * Switches every registered thread to pinned or floating placement. Returns 0, or -EBUSY when a
+ * thread stayed runnable too long; that thread keeps its previous mask. Main thread only.
+ */
+int cpu_affinity_set_pinned(bool pinned);
+
+bool cpu_affinity_pinned(void);
+
+#else
+
+static inline void cpu_affinity_register(struct k_thread *thread, enum cpu_role role, uint32_t index)
+{
+    ARG_UNUSED(thread);
+    ARG_UNUSED(role);
+    ARG_UNUSED(index);
+}
+
+#endif /* CONFIG_TELEMETRY_CPU_PINNING */
+
+#endif /* CPU_AFFINITY_H_ */
@@ -0,0 +1,134 @@
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/atomic.h>
+
+#include "cpu_stats.h"
+#include "frame_rate.h"
+
+/* ========== Global Variables ========== */
+
+struct cpu_frame_time cpu_frame_time;
+
+/* Execution cycles of every thread at the previous report, monitor thread only */
+struct thread_sample {
+    const struct k_thread *thread;
+    uint64_t last_cycles;
+    uint64_t delta_cycles;
+    bool     seen;
+};
+
+static struct thread_sample thread_samples[CPU_STATS_MAX_THREADS];
+static k_thread_runtime_stats_t last_all;
+
+/* ========== Helpers ========== */
+
+static struct thread_sample *thread_sample_get(const struct k_thread *thread)
+{
+    struct thread_sample *free_slot = NULL;
+
+    for (int i = 0; i < CPU_STATS_MAX_THREADS; i++) {
+        if (thread_samples[i].thread == thread) {
+            return &thread_samples[i];
+        }
+        if (free_slot == NULL && thread_samples[i].thread == NULL) {
+            free_slot = &thread_samples[i];
+        }
+    }
+
+    if (free_slot != NULL) {
+        free_slot->thread = thread;
+        free_slot->last_cycles = 0;
+    }
+
+    return free_slot;
+}
+
+/* Runs with the thread list locked: only collects, printing happens afterwards */
+static void sample_thread(const struct k_thread *thread, void *user_data)
+{
+    ARG_UNUSED(user_data);
+
+    k_thread_runtime_stats_t stats;
+    struct thread_sample *sample;
+
+    if (k_thread_runtime_stats_get((k_tid_t)thread, &stats) != 0) {
+        return;
+    }
+
+    sample = thread_sample_get(thread);
+    if (sample == NULL) {
+        return;
+    }
+
+    sample->delta_cycles = stats.execution_cycles - sample->last_cycles;
+    sample->last_cycles = stats.execution_cycles;
+    sample->seen = true;
+}
+
+/* Share of total in tenths of a percent */
+static uint32_t permille(uint64_t part, uint64_t total)
+{
+    return total == 0 ? 0 : (uint32_t)((part * 1000 + total / 2) / total);
+}
+
+/* ========== Public Functions ========== */
+
+void cpu_stats_init(void)
+{
+    k_thread_runtime_stats_all_get(&last_all);
+    k_thread_foreach(sample_thread, NULL);
+}
+
+void cpu_stats_report(void)
+{
+    k_thread_runtime_stats_t all;
+    uint64_t total;
+    uint32_t share;
+
+    for (int i = 0; i < CPU_STATS_MAX_THREADS; i++) {
+        thread_samples[i].seen = false;
+    }
+
+    k_thread_runtime_stats_all_get(&all);
+    k_thread_foreach(sample_thread, NULL);
+
+    total = all.execution_cycles - last_all.execution_cycles;
+    share = permille(all.idle_cycles - last_all.idle_cycles, total);
+    last_all = all;
+
+    printk("--- CPU: idle %u.%u%%", share / 10, share % 10);
+
+    for (int i = 0; i < CPU_STATS_MAX_THREADS; i++) {
+        struct thread_sample *sample = &thread_samples[i];
+
+        if (sample->thread == NULL) {
+            continue;
+        }
+        if (!sample->seen) {
+            sample->thread = NULL;  /* thread exited, free the slot */
+            continue;
+        }
+
+        const char *name = k_thread_name_get((k_tid_t)sample->thread);
+
+        share = permille(sample->delta_cycles, total);
+        if (name != NULL && name[0] != '\0') {
+            printk(" | %s %u.%u%%", name, share / 10, share % 10);
+        } else {
+            printk(" | %p %u.%u%%", sample->thread, share / 10, share % 10);
+        }
+    }
+
+    /* Snapshot and restart the frame time interval; a frame recorded in between may be split */
+    uint32_t frames = (uint32_t)atomic_clear(&cpu_frame_time.frames);
+    uint32_t sum_us = (uint32_t)atomic_clear(&cpu_frame_time.sum_us);
+    uint32_t min_us = (uint32_t)atomic_get(&cpu_frame_time.min_us);
+    uint32_t max_us = (uint32_t)atomic_clear(&cpu_frame_time.max_us);
+
+    if (frames > 0) {
+        printk(" | frame min/avg/max %u/%u/%u us of %u ms", min_us, sum_us / frames, max_us,
+               frame_rate_period_ms());
+    }
+    printk(" ---\n");
+}
@@ -0,0 +1,50 @@
+#ifndef CPU_STATS_H_
+#define CPU_STATS_H_
+
+#include <stdint.h>
+#include <zephyr/sys/atomic.h>
+
+/*
+ * CPU utilization surface for the monitor thread (CONFIG_TELEMETRY_CPU_STATS).
+ *
+ * Per-thread and idle shares come from the kernel's thread runtime statistics and are computed
+ * over the interval since the previous report, so they reflect current load rather than the
+ * average since boot. The aggregator additionally records its execution time per frame, from the
+ * timer wakeup to the end of frame assembly, to size the headroom before the frame deadline.
+ */
+
+/* Number of threads tracked; threads beyond this are not reported */
+#define CPU_STATS_MAX_THREADS       16
+
+struct cpu_frame_time {
+    atomic_t min_us;
+    atomic_t max_us;
+    atomic_t sum_us;
+    atomic_t frames;
+};
+
+extern struct cpu_frame_time cpu_frame_time;
+
+/* Aggregator only: execution time of one frame */
+static inline void cpu_stats_frame(uint32_t busy_us)
+{
+    if (atomic_get(&cpu_frame_time.frames) == 0 || busy_us < (uint32_t)atomic_get(&cpu_frame_time.min_us)) {
+        atomic_set(&cpu_frame_time.min_us, (atomic_val_t)busy_us);
+    }
+    if (busy_us > (uint32_t)atomic_get(&cpu_frame_time.max_us)) {
+        atomic_set(&cpu_frame_time.max_us, (atomic_val_t)busy_us);
+    }
+    atomic_add(&cpu_frame_time.sum_us, (atomic_val_t)busy_us);
+    atomic_inc(&cpu_frame_time.frames);
+}
+
+/* Takes the first runtime snapshot; the first report covers the time since this call */
+void cpu_stats_init(void);
+
+/*
+ * Prints one CPU line: idle and per-thread shares since the previous call and the aggregator
+ * frame time min/avg/max against the frame period, then starts a new interval. Monitor thread only.
+ */
+void cpu_stats_report(void);
+
+#endif /* CPU_STATS_H_ */
@@ -0,0 +1,68 @@
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#include "footprint.h"
+
+void footprint_report_ram(void)
+{
+    uint32_t total = 0;
+
+    printk("--- RAM:");
+    STRUCT_SECTION_FOREACH(telemetry_footprint, entry) {
+        printk(" | %s %u", entry->name, entry->bytes);
+        total += entry->bytes;
+    }
+    printk(" | total %u bytes ---\n", total);
+}
+
+struct stack_sample {
+    const char *name;
+    size_t size;
+    size_t unused;
+};
+
+#define FOOTPRINT_MAX_THREADS       16
+
+struct stack_report {
+    struct stack_sample samples[FOOTPRINT_MAX_THREADS];
+    uint32_t count;
+};
+
+/* Only collects; printing happens afterwards, outside the thread walk */
+static void sample_stack(const struct k_thread *thread, void *user_data)
+{
+    struct stack_report *report = user_data;
+    struct stack_sample *sample;
+
+    if (report->count == FOOTPRINT_MAX_THREADS) {
+        return;
+    }
+
+    sample = &report->samples[report->count];
+    if (k_thread_stack_space_get(thread, &sample->unused) != 0) {
+        return;
+    }
+    sample->name = k_thread_name_get((k_tid_t)thread);
+    sample->size = thread->stack_info.size;
+    report->count++;
+}
+
+void footprint_report_stacks(void)
+{
+    static struct stack_report report;  /* monitor thread only, kept off its stack */
+
+    report.count = 0;
+    /* Unlocked like the kernel shell: scanning every stack with the lock held would block interrupts */
+    k_thread_foreach_unlocked(sample_stack, &report);
+
+    printk("--- STACK used/size:");
+    for (uint32_t i = 0; i < report.count; i++) {
+        const struct stack_sample *sample = &report.samples[i];
+        size_t used = sample->size - sample->unused;
+
+        printk(" | %s %u/%u (%u%%)", sample->name != NULL ? sample->name : "?", (uint32_t)used,
+               (uint32_t)sample->size, (uint32_t)(sample->size ? used * 100 / sample->size : 0));
+    }
+    printk(" ---\n");
+}
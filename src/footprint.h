@@ -0,0 +1,46 @@
+#ifndef FOOTPRINT_H_
+#define FOOTPRINT_H_
+
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Memory footprint diagnostics (CONFIG_TELEMETRY_FOOTPRINT).
+ *
+ * Modules tag their static queues and buffers with TELEMETRY_FOOTPRINT_DEFINE(), which places a
+ * const entry in the telemetry_footprint iterable section, the same way sensor channels register.
+ * Without the option the macro only checks that the size expression is valid.
+ * The stack report walks every thread and reads its unused stack space as left by
+ * CONFIG_INIT_STACKS, so it shows the high-water mark since boot.
+ * scripts/footprint.py summarizes the whole image per subsystem from the linker map at build time.
+ */
+
+struct telemetry_footprint {
+    const char *name;
+    uint32_t bytes;
+};
+
+#if defined(CONFIG_TELEMETRY_FOOTPRINT)
+#define TELEMETRY_FOOTPRINT_DEFINE(_id, _name, _bytes)                                          \
+    static const STRUCT_SECTION_ITERABLE(telemetry_footprint, _CONCAT(telemetry_footprint_, _id)) = { \
+        .name = (_name),                                                                        \
+        .bytes = (uint32_t)(_bytes),                                                            \
+    }
+#else
+#define TELEMETRY_FOOTPRINT_DEFINE(_id, _name, _bytes)                                          \
+    BUILD_ASSERT((_bytes) > 0, "footprint entry " #_id " has no size")
+#endif
+
+#if defined(CONFIG_TELEMETRY_FOOTPRINT)
+
+/* Prints every registered buffer and their total. Static, so once at boot is enough. */
+void footprint_report_ram(void);
+
+/* Prints used/size and the headroom of every thread stack. Monitor thread only. */
+void footprint_report_stacks(void);
+
+#endif
+
+#endif /* FOOTPRINT_H_ */
@@ -0,0 +1,456 @@
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "frame_codec.h"
+#include "frame_pool.h"
+
+/* ========== Varint Helpers ========== */
+
+struct codec_cursor {
+    uint8_t *out;           /* encoder side */
+    const uint8_t *in;      /* decoder side */
+    size_t pos;
+    size_t size;
+    bool overflow;
+};
+
+static inline uint64_t zigzag_encode(int64_t value)
+{
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static inline int64_t zigzag_decode(uint64_t value)
+{
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static void put_varint(struct codec_cursor *cur, uint64_t value)
+{
+    do {
+        uint8_t byte = value & 0x7f;
+
+        value >>= 7;
+        if (value != 0) {
+            byte |= 0x80;
+        }
+        if (cur->pos >= cur->size) {
+            cur->overflow = true;
+            return;
+        }
+        cur->out[cur->pos++] = byte;
+    } while (value != 0);
+}
+
+static void put_svarint(struct codec_cursor *cur, int64_t value)
+{
+    put_varint(cur, zigzag_encode(value));
+}
+
+static uint64_t get_varint(struct codec_cursor *cur)
+{
+    uint64_t value = 0;
+
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+        if (cur->pos >= cur->size) {
+            break;
+        }
+
+        uint8_t byte = cur->in[cur->pos++];
+
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+
+    cur->overflow = true;
+    return 0;
+}
+
+static int64_t get_svarint(struct codec_cursor *cur)
+{
+    return zigzag_decode(get_varint(cur));
+}
+
+/* ========== Optional Fields ========== */
+
+/* Spread fields are deltas like the other channel fields; without CONFIG_TELEMETRY_WINDOW_STATS they are skipped */
+static void get_spread(struct codec_cursor *cur, struct telemetry_channel_stats *stats,
+                       const struct telemetry_channel_stats *ref)
+{
+    int32_t stddev = (int32_t)get_svarint(cur);
+    int32_t p50 = (int32_t)get_svarint(cur);
+    int32_t p95 = (int32_t)get_svarint(cur);
+
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+    stats->stddev = stddev + (ref != NULL ? ref->stddev : 0);
+    stats->p50 = p50 + (ref != NULL ? ref->p50 : 0);
+    stats->p95 = p95 + (ref != NULL ? ref->p95 : 0);
+#else
+    ARG_UNUSED(stats);
+    ARG_UNUSED(ref);
+    ARG_UNUSED(stddev);
+    ARG_UNUSED(p50);
+    ARG_UNUSED(p95);
+#endif
+}
+
+static void put_rollups(struct codec_cursor *cur, const struct telemetry_frame *frame)
+{
+#if defined(CONFIG_TELEMETRY_ROLLUP)
+    put_varint(cur, frame->rollup_closed);
+    for (uint32_t level = 0; level < TELEMETRY_ROLLUP_LEVELS; level++) {
+        const struct telemetry_rollup *bucket = &frame->rollups[level];
+
+        if ((frame->rollup_closed & BIT(level)) == 0) {
+            continue;
+        }
+        put_varint(cur, (uint64_t)(frame->timestamp - bucket->start));
+        put_svarint(cur, bucket->sum);
+        put_svarint(cur, bucket->min);
+        put_svarint(cur, bucket->max);
+        put_varint(cur, bucket->count);
+    }
+#else
+    ARG_UNUSED(cur);
+    ARG_UNUSED(frame);
+#endif
+}
+
+/* Records from a build with rollups decode everywhere; without CONFIG_TELEMETRY_ROLLUP they are skipped */
+static void get_rollups(struct codec_cursor *cur, struct telemetry_frame *frame)
+{
+#if defined(CONFIG_TELEMETRY_ROLLUP)
+    struct telemetry_rollup *rollups = frame->rollups;
+#else
+    struct telemetry_rollup rollups[TELEMETRY_ROLLUP_LEVELS];
+#endif
+    uint64_t mask = get_varint(cur);
+
+    for (uint32_t level = 0; level < TELEMETRY_ROLLUP_LEVELS; level++) {
+        struct telemetry_rollup *bucket = &rollups[level];
+
+        if ((mask & BIT(level)) == 0) {
+            continue;
+        }
+        bucket->start = frame->timestamp - (int64_t)get_varint(cur);
+        bucket->sum = get_svarint(cur);
+        bucket->min = (int32_t)get_svarint(cur);
+        bucket->max = (int32_t)get_svarint(cur);
+        bucket->count = (uint32_t)get_varint(cur);
+    }
+#if defined(CONFIG_TELEMETRY_ROLLUP)
+    frame->rollup_closed = (uint8_t)(mask & BIT_MASK(TELEMETRY_ROLLUP_LEVELS));
+#endif
+}
+
+/* ========== Codec Functions ========== */
+
+void frame_codec_init(struct frame_codec *codec, uint32_t keyframe_interval)
+{
+    *codec = (struct frame_codec){0};
+    codec->keyframe_interval = MAX(keyframe_interval, 1U);
+}
+
+/* Advances the reference after a record was encoded or decoded, identically on both sides */
+static void update_reference(struct frame_codec *codec, const struct telemetry_frame *frame, bool keyframe)
+{
+    codec->ts_step = (codec->have_ref && !keyframe) ? frame->timestamp - codec->ref.timestamp : 0;
+
+    if (frame->gap) {
+        /* Gap records carry no data, keep the data fields of the previous frame as reference */
+        codec->ref.frame_id = frame->frame_id;
+        codec->ref.timestamp = frame->timestamp;
+        /* A reader starting at a gap keyframe has no data fields to apply the next delta to */
+        codec->have_data = codec->have_data && !keyframe;
+    } else {
+        codec->ref = *frame;
+        codec->have_data = true;
+    }
+
+    codec->since_keyframe = keyframe ? 1 : codec->since_keyframe + 1;
+    codec->have_ref = true;
+}
+
+size_t frame_codec_encode(struct frame_codec *codec, const struct telemetry_frame *frame,
+                          uint8_t *buf, size_t size)
+{
+    struct codec_cursor cur = { .out = buf, .size = size };
+    /* A due periodic keyframe waits for the next data record, a gap keyframe would not resync the data */
+    bool keyframe = !codec->have_ref ||
+                    (!frame->gap && (!codec->have_data || codec->since_keyframe >= codec->keyframe_interval ||
+                                     frame->channel_count != codec->ref.channel_count));
+    uint8_t flags = 0;
+
+    flags |= keyframe ? FRAME_CODEC_FLAG_KEYFRAME : 0;
+    flags |= frame->degraded ? FRAME_CODEC_FLAG_DEGRADED : 0;
+    flags |= frame->gap ? FRAME_CODEC_FLAG_GAP : 0;
+    flags |= frame->slot_count != 1 ? FRAME_CODEC_FLAG_SLOTS : 0;
+#if defined(CONFIG_TELEMETRY_ROLLUP)
+    flags |= (!frame->gap && frame->rollup_closed != 0) ? FRAME_CODEC_FLAG_ROLLUP : 0;
+#endif
+    flags |= IS_ENABLED(CONFIG_TELEMETRY_WINDOW_STATS) && !frame->gap ? FRAME_CODEC_FLAG_SPREAD : 0;
+    put_varint(&cur, flags);
+
+    if (keyframe) {
+        put_varint(&cur, frame->frame_id);
+        put_svarint(&cur, frame->timestamp);
+    } else {
+        put_svarint(&cur, (int32_t)(frame->frame_id - codec->ref.frame_id - 1));
+        put_svarint(&cur, (frame->timestamp - codec->ref.timestamp) - codec->ts_step);
+    }
+
+    if (flags & FRAME_CODEC_FLAG_SLOTS) {
+        put_varint(&cur, frame->slot_count);
+    }
+
+    if (!frame->gap) {
+        if (keyframe) {
+            put_varint(&cur, frame->uptime);
+            put_varint(&cur, frame->channel_count);
+        } else {
+            put_svarint(&cur, (int64_t)frame->uptime - (int64_t)codec->ref.uptime);
+        }
+
+        for (uint32_t ch = 0; ch < frame->channel_count; ch++) {
+            const struct telemetry_channel_stats *stats = &frame->channels[ch];
+            const struct telemetry_channel_stats *ref = &codec->ref.channels[ch];
+
+            if (keyframe) {
+                put_svarint(&cur, stats->latest);
+                put_svarint(&cur, stats->avg);
+                put_svarint(&cur, stats->min);
+                put_svarint(&cur, stats->max);
+            } else {
+                put_svarint(&cur, (int64_t)stats->latest - ref->latest);
+                put_svarint(&cur, (int64_t)stats->avg - ref->avg);
+                put_svarint(&cur, (int64_t)stats->min - ref->min);
+                put_svarint(&cur, (int64_t)stats->max - ref->max);
+            }
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+            put_svarint(&cur, (int64_t)stats->stddev - (keyframe ? 0 : ref->stddev));
+            put_svarint(&cur, (int64_t)stats->p50 - (keyframe ? 0 : ref->p50));
+            put_svarint(&cur, (int64_t)stats->p95 - (keyframe ? 0 : ref->p95));
+#endif
+        }
+
+        if (flags & FRAME_CODEC_FLAG_ROLLUP) {
+            put_rollups(&cur, frame);
+        }
+    }
+
+    if (cur.overflow) {
+        return 0;
+    }
+
+    update_reference(codec, frame, keyframe);
+
+    return cur.pos;
+}
+
+int frame_codec_decode(struct frame_codec *codec, const uint8_t *buf, size_t size,
+                       struct telemetry_frame *frame)
+{
+    struct codec_cursor cur = { .in = buf, .size = size };
+    uint8_t flags = (uint8_t)get_varint(&cur);
+    bool keyframe = (flags & FRAME_CODEC_FLAG_KEYFRAME) != 0;
+
+    if (!keyframe && !codec->have_ref) {
+        return -EAGAIN;
+    }
+    if (!keyframe && (flags & FRAME_CODEC_FLAG_GAP) == 0 && !codec->have_data) {
+        codec->have_ref = false;    /* the encoder never sends this, wait for the next keyframe */
+        return -EAGAIN;
+    }
+
+    *frame = (struct telemetry_frame){0};
+    frame->degraded = (flags & FRAME_CODEC_FLAG_DEGRADED) != 0;
+    frame->gap = (flags & FRAME_CODEC_FLAG_GAP) != 0;
+
+    if (keyframe) {
+        frame->frame_id = (uint32_t)get_varint(&cur);
+        frame->timestamp = get_svarint(&cur);
+    } else {
+        frame->frame_id = codec->ref.frame_id + 1 + (uint32_t)get_svarint(&cur);
+        frame->timestamp = codec->ref.timestamp + codec->ts_step + get_svarint(&cur);
+    }
+
+    frame->slot_count = (flags & FRAME_CODEC_FLAG_SLOTS) ? (uint16_t)get_varint(&cur) : 1;
+
+    if (!frame->gap) {
+        if (keyframe) {
+            frame->uptime = (uint32_t)get_varint(&cur);
+            uint64_t channel_count = get_varint(&cur);
+
+            if (channel_count > CONFIG_TELEMETRY_MAX_CHANNELS) {
+                codec->have_ref = false;
+                return -EINVAL;
+            }
+            frame->channel_count = (uint8_t)channel_count;
+        } else {
+            frame->uptime = codec->ref.uptime + (uint32_t)get_svarint(&cur);
+            frame->channel_count = codec->ref.channel_count;
+        }
+
+        for (uint32_t ch = 0; ch < frame->channel_count; ch++) {
+            struct telemetry_channel_stats *stats = &frame->channels[ch];
+            const struct telemetry_channel_stats *ref = &codec->ref.channels[ch];
+            int32_t base_latest = keyframe ? 0 : ref->latest;
+            int32_t base_avg = keyframe ? 0 : ref->avg;
+            int32_t base_min = keyframe ? 0 : ref->min;
+            int32_t base_max = keyframe ? 0 : ref->max;
+
+            stats->latest = base_latest + (int32_t)get_svarint(&cur);
+            stats->avg = base_avg + (int32_t)get_svarint(&cur);
+            stats->min = base_min + (int32_t)get_svarint(&cur);
+            stats->max = base_max + (int32_t)get_svarint(&cur);
+            if (flags & FRAME_CODEC_FLAG_SPREAD) {
+                get_spread(&cur, stats, keyframe ? NULL : ref);
+            }
+        }
+
+        if (frame->channel_count > 0) {
+            frame->latest_sensor_value = frame->channels[0].latest;
+            frame->sensor_avg_last_200ms = frame->channels[0].avg < 0 ? 0 : (uint32_t)frame->channels[0].avg;
+            frame->sensor_min_last_200ms = frame->channels[0].min;
+            frame->sensor_max_last_200ms = frame->channels[0].max;
+        }
+
+        if (flags & FRAME_CODEC_FLAG_ROLLUP) {
+            get_rollups(&cur, frame);
+        }
+    }
+
+    if (cur.overflow) {
+        codec->have_ref = false;  /* resync at the next keyframe */
+        return -EINVAL;
+    }
+
+    update_reference(codec, frame, keyframe);
+
+    return (int)cur.pos;
+}
+
+/* ========== Batch Functions ========== */
+
+void frame_batch_init(struct frame_batch *batch, uint8_t *buf, size_t size)
+{
+    batch->buf = buf;
+    batch->size = (uint16_t)size;
+    batch->len = FRAME_BATCH_HDR_SIZE;
+    batch->hdr = (struct frame_batch_header){0};
+    frame_codec_init(&batch->codec, UINT32_MAX);  /* one keyframe, at the start of the batch */
+}
+
+bool frame_batch_add(struct frame_batch *batch, const struct telemetry_frame *frame)
+{
+    uint8_t record[FRAME_CODEC_MAX_SIZE];
+    struct frame_codec saved = batch->codec;
+    size_t len = frame_codec_encode(&batch->codec, frame, record, sizeof(record));
+    size_t prefix = len >= 0x80 ? 2 : 1;
+
+    if (len == 0 || batch->len + prefix + len > batch->size) {
+        batch->codec = saved;  /* the record goes into the next batch, as its keyframe */
+        return false;
+    }
+
+    if (batch->hdr.count == 0) {
+        batch->hdr.first_id = frame->frame_id;
+    }
+    batch->hdr.last_id = frame->frame_id + MAX(frame->slot_count, 1U) - 1;
+    batch->hdr.count++;
+
+    batch->buf[batch->len++] = (uint8_t)(len & 0x7f) | (prefix == 2 ? 0x80 : 0);
+    if (prefix == 2) {
+        batch->buf[batch->len++] = (uint8_t)(len >> 7);
+    }
+    memcpy(&batch->buf[batch->len], record, len);
+    batch->len += len;
+
+    return true;
+}
+
+uint16_t frame_batch_push(struct frame_batch *batch, const struct telemetry_frame *frame, void (*flush)(void))
+{
+    if (!frame_batch_add(batch, frame)) {
+        /* Batch full: the frame becomes the keyframe of the next batch */
+        flush();
+        frame_batch_add(batch, frame);
+    }
+    frame_pool_release(frame);  /* encoded into the batch, the pool block is no longer needed */
+
+    return frame_batch_count(batch);
+}
+
+size_t frame_batch_finish(struct frame_batch *batch)
+{
+    batch->hdr.len = batch->len;
+
+    sys_put_le32(batch->hdr.first_id, &batch->buf[0]);
+    sys_put_le32(batch->hdr.last_id, &batch->buf[4]);
+    sys_put_le16(batch->hdr.count, &batch->buf[8]);
+    sys_put_le16(batch->hdr.len, &batch->buf[10]);
+
+    return batch->len;
+}
+
+int frame_batch_parse_header(const uint8_t *buf, size_t size, struct frame_batch_header *hdr)
+{
+    if (size < FRAME_BATCH_HDR_SIZE) {
+        return -EINVAL;
+    }
+
+    hdr->first_id = sys_get_le32(&buf[0]);
+    hdr->last_id = sys_get_le32(&buf[4]);
+    hdr->count = sys_get_le16(&buf[8]);
+    hdr->len = sys_get_le16(&buf[10]);
+
+    return (hdr->len < FRAME_BATCH_HDR_SIZE || hdr->len > size) ? -EINVAL : 0;
+}
+
+int frame_batch_reader_init(struct frame_batch_reader *reader, const uint8_t *buf, size_t size)
+{
+    struct frame_batch_header hdr;
+    int rc = frame_batch_parse_header(buf, size, &hdr);
+
+    reader->buf = buf;
+    reader->pos = FRAME_BATCH_HDR_SIZE;
+    reader->len = rc == 0 ? hdr.len : 0;
+    reader->remaining = rc == 0 ? hdr.count : 0;
+    frame_codec_init(&reader->codec, UINT32_MAX);
+
+    return rc;
+}
+
+int frame_batch_next(struct frame_batch_reader *reader, struct telemetry_frame *frame)
+{
+    if (reader->remaining == 0) {
+        return -ENOENT;
+    }
+    if (reader->pos >= reader->len) {
+        reader->remaining = 0;
+        return -EINVAL;
+    }
+
+    size_t len = reader->buf[reader->pos] & 0x7f;
+
+    if (reader->buf[reader->pos++] & 0x80) {
+        if (reader->pos >= reader->len) {
+            reader->remaining = 0;
+            return -EINVAL;
+        }
+        len |= (size_t)reader->buf[reader->pos++] << 7;
+    }
+    if (reader->pos + len > reader->len ||
+        frame_codec_decode(&reader->codec, &reader->buf[reader->pos], len, frame) < 0) {
+        reader->remaining = 0;
+        return -EINVAL;
+    }
+
+    reader->pos += len;
+    reader->remaining--;
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+#ifndef FRAME_CODEC_H_
+#define FRAME_CODEC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "telemetry.h"
+
+/*
+ * Compact binary encoding of struct telemetry_frame.
+ *
+ * Every record starts with a flags byte. Keyframes carry absolute values; delta frames carry the
+ * difference to a prediction from the previous record of the same codec instance: frame_id is
+ * predicted as the next id, the timestamp as the last timestamp step, everything else as unchanged. Signed values are zig-zag mapped
+ * and every number is a LEB128 varint, so a steady 5 Hz frame needs about one byte per field.
+ *
+ * A keyframe is emitted every keyframe_interval records, when the channel count changes and on
+ * frame_codec_force_keyframe(), so a reader that lost data can resync at the next keyframe.
+ * Gap records carry no channel data and never act as the periodic keyframe: a gap that starts a
+ * stream is a keyframe for frame_id and timestamp only, and the next data record is a keyframe too.
+ * The single-sensor fields are not encoded; the decoder restores them from channel 0.
+ * scripts/frame_decode.py implements the same decoder on the host.
+ */
+
+#define FRAME_CODEC_FLAG_KEYFRAME   BIT(0)
+#define FRAME_CODEC_FLAG_DEGRADED   BIT(1)
+#define FRAME_CODEC_FLAG_GAP        BIT(2)  /* gap record, no uptime and channel fields */
+#define FRAME_CODEC_FLAG_SLOTS      BIT(3)  /* slot_count field present, otherwise 1 */
+#define FRAME_CODEC_FLAG_ROLLUP     BIT(4)  /* closed rollup buckets follow the channel fields */
+#define FRAME_CODEC_FLAG_SPREAD     BIT(5)  /* every channel also carries stddev, p50 and p95 */
+
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+#define FRAME_CODEC_CHANNEL_FIELDS  7
+#else
+#define FRAME_CODEC_CHANNEL_FIELDS  4
+#endif
+
+/* Closed level mask, then per closed level: age of its start, sum, min, max and count, all absolute */
+#if defined(CONFIG_TELEMETRY_ROLLUP)
+#define FRAME_CODEC_ROLLUP_SIZE     (1 + TELEMETRY_ROLLUP_LEVELS * (2 * 10 + 3 * 5))
+#else
+#define FRAME_CODEC_ROLLUP_SIZE     0
+#endif
+
+/* Worst case record size: flags, five 64-bit varints, the 32-bit varints of every channel and the rollups */
+#define FRAME_CODEC_MAX_SIZE        (1 + 5 * 10 + CONFIG_TELEMETRY_MAX_CHANNELS * FRAME_CODEC_CHANNEL_FIELDS * 5 + \
+                                     FRAME_CODEC_ROLLUP_SIZE)
+
+struct frame_codec {
+    struct telemetry_frame ref;     /* previous record, reference for the next delta */
+    int64_t  ts_step;               /* last timestamp difference */
+    uint32_t keyframe_interval;
+    uint32_t since_keyframe;
+    bool     have_ref;
+    bool     have_data;             /* ref holds the data fields of a decoded or encoded data record */
+};
+
+void frame_codec_init(struct frame_codec *codec, uint32_t keyframe_interval);
+
+/* The next record is encoded as a keyframe */
+static inline void frame_codec_force_keyframe(struct frame_codec *codec)
+{
+    codec->have_ref = false;
+}
+
+/* Encodes frame into buf. Returns the record length, or 0 when size is too small. */
+size_t frame_codec_encode(struct frame_codec *codec, const struct telemetry_frame *frame,
+                          uint8_t *buf, size_t size);
+
+/*
+ * Decodes one record from buf into frame. Returns the number of bytes consumed, -EAGAIN for a delta
+ * record before the first keyframe (skip it and keep decoding), or -EINVAL for a malformed record.
+ */
+int frame_codec_decode(struct frame_codec *codec, const uint8_t *buf, size_t size,
+                       struct telemetry_frame *frame);
+
+/*
+ * Self-contained batch of records, the unit of the flash log and of network datagrams.
+ * A FRAME_BATCH_HDR_SIZE header (first frame_id, last covered frame_id, record count, used bytes,
+ * all little endian) is followed by records prefixed with their length as a one or two byte varint.
+ * The first record is a keyframe, so every batch decodes on its own.
+ */
+
+#define FRAME_BATCH_HDR_SIZE        12
+#define FRAME_BATCH_RECORD_MAX      (2 + FRAME_CODEC_MAX_SIZE)  /* length prefix and worst case record */
+
+struct frame_batch_header {
+    uint32_t first_id;
+    uint32_t last_id;
+    uint16_t count;
+    uint16_t len;
+};
+
+struct frame_batch {
+    uint8_t  *buf;
+    uint16_t size;
+    uint16_t len;           /* 0 until frame_batch_init(), owners may use it as a free marker */
+    struct frame_batch_header hdr;
+    struct frame_codec codec;
+};
+
+/* buf must hold at least FRAME_BATCH_HDR_SIZE + FRAME_BATCH_RECORD_MAX bytes and less than 16 KiB */
+void frame_batch_init(struct frame_batch *batch, uint8_t *buf, size_t size);
+
+/* Appends a frame. Returns false, leaving the batch unchanged, when it does not fit. */
+bool frame_batch_add(struct frame_batch *batch, const struct telemetry_frame *frame);
+
+/*
+ * Sink side: appends a frame taken from a frame consumer and releases its pool block. A frame that does
+ * not fit makes flush() empty the batch and then opens the next batch. Returns the batch's frame count.
+ */
+uint16_t frame_batch_push(struct frame_batch *batch, const struct telemetry_frame *frame, void (*flush)(void));
+
+/* Writes the header and returns the batch length */
+size_t frame_batch_finish(struct frame_batch *batch);
+
+static inline uint16_t frame_batch_count(const struct frame_batch *batch)
+{
+    return batch->hdr.count;
+}
+
+/* Returns 0, or -EINVAL when buf is too short for the header or the length it declares */
+int frame_batch_parse_header(const uint8_t *buf, size_t size, struct frame_batch_header *hdr);
+
+struct frame_batch_reader {
+    const uint8_t *buf;
+    uint16_t pos;
+    uint16_t len;
+    uint16_t remaining;
+    struct frame_codec codec;
+};
+
+/* Starts decoding a finished batch. Returns frame_batch_parse_header()'s result. */
+int frame_batch_reader_init(struct frame_batch_reader *reader, const uint8_t *buf, size_t size);
+
+/* Returns 0 and the next frame, -ENOENT after the last record, or -EINVAL for a corrupt batch */
+int frame_batch_next(struct frame_batch_reader *reader, struct telemetry_frame *frame);
+
+#endif /* FRAME_CODEC_H_ */
@@ -0,0 +1,79 @@
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+
+#include "frame_history.h"
+#include "footprint.h"
+
+/* ========== Constants ========== */
+
+#define HISTORY_DEPTH               CONFIG_TELEMETRY_HISTORY_DEPTH
+#define HISTORY_MASK                (HISTORY_DEPTH - 1)
+#define HISTORY_RETRIES             8
+
+BUILD_ASSERT(IS_POWER_OF_TWO(HISTORY_DEPTH), "CONFIG_TELEMETRY_HISTORY_DEPTH must be a power of two");
+
+/* ========== Global Variables ========== */
+
+struct history_slot {
+    atomic_t seq;           /* odd while the aggregator writes the slot */
+    uint32_t serial;        /* number of the frame in the slot */
+    struct telemetry_frame frame;
+};
+
+static struct history_slot history[HISTORY_DEPTH];
+static atomic_t history_written;    /* written by the aggregator only */
+TELEMETRY_FOOTPRINT_DEFINE(frame_history, "frame history", sizeof(history));
+
+/* ========== History Functions ========== */
+
+void frame_history_record(const struct telemetry_frame *frame)
+{
+    uint32_t serial = (uint32_t)atomic_get(&history_written);
+    struct history_slot *slot = &history[serial & HISTORY_MASK];
+
+    atomic_inc(&slot->seq);
+    barrier_dmem_fence_full();  /* the odd count is visible before any byte of the frame */
+    slot->serial = serial;
+    slot->frame = *frame;
+    atomic_inc(&slot->seq);
+
+    atomic_set(&history_written, (atomic_val_t)(serial + 1));
+}
+
+uint32_t frame_history_count(void)
+{
+    return (uint32_t)atomic_get(&history_written);
+}
+
+/* The copy can be torn while the aggregator writes the slot; it only counts when seq was stable and even */
+int frame_history_get(uint32_t serial, struct telemetry_frame *frame)
+{
+    for (int retry = 0; retry < HISTORY_RETRIES; retry++) {
+        uint32_t written = frame_history_count();
+
+        if (serial >= written || written - serial > HISTORY_DEPTH) {
+            return -ENOENT;
+        }
+
+        const struct history_slot *slot = &history[serial & HISTORY_MASK];
+        atomic_val_t seq = atomic_get(&slot->seq);
+
+        if ((seq & 1) != 0) {
+            continue;
+        }
+        uint32_t slot_serial = slot->serial;
+
+        *frame = slot->frame;
+        barrier_dmem_fence_full();  /* the frame is copied before seq is checked again */
+        if (atomic_get(&slot->seq) != seq) {
+            continue;
+        }
+
+        /* A stable slot holding a newer frame means this one was overwritten */
+        return slot_serial == serial ? 0 : -ENOENT;
+    }
+
+    return -EAGAIN;
+}
@@ -0,0 +1,41 @@
+#ifndef FRAME_HISTORY_H_
+#define FRAME_HISTORY_H_
+
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+#include "telemetry.h"
+
+/*
+ * In-RAM history of the last CONFIG_TELEMETRY_HISTORY_DEPTH frames (CONFIG_TELEMETRY_HISTORY).
+ *
+ * The aggregator copies every frame it builds, gap frames included, into a fixed ring. Each slot is
+ * guarded by its own sequence counter (a seqlock): the writer makes it odd, copies the frame and makes
+ * it even again, and never waits for a reader. A reader copies the slot out and retries when the
+ * counter was odd or changed meanwhile, so reading from any thread never stalls the aggregator.
+ */
+
+#if defined(CONFIG_TELEMETRY_HISTORY)
+
+/* Aggregator only. Copies the finished frame into the oldest slot. */
+void frame_history_record(const struct telemetry_frame *frame);
+
+/* Frames recorded since boot. Frames are numbered from 0, the newest is frame_history_count() - 1. */
+uint32_t frame_history_count(void);
+
+/*
+ * Copies frame number serial into frame. Returns 0, -ENOENT when it is not or no longer in the history,
+ * or -EAGAIN when the aggregator was writing its slot during every retry.
+ */
+int frame_history_get(uint32_t serial, struct telemetry_frame *frame);
+
+#else
+
+static inline void frame_history_record(const struct telemetry_frame *frame)
+{
+    ARG_UNUSED(frame);
+}
+
+#endif /* CONFIG_TELEMETRY_HISTORY */
+
+#endif /* FRAME_HISTORY_H_ */
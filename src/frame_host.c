@@ -0,0 +1,154 @@
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+
+#include "soc.h"
+#include "cmdline.h"    /* native_sim command line options */
+
+#include "frame_host.h"
+#include "frame_host_native.h"
+#include "frame_codec.h"
+#include "frame_pool.h"
+#include "queue_stats.h"
+#include "footprint.h"
+#include "cpu_affinity.h"
+#include "sched_edf.h"
+
+LOG_MODULE_DECLARE(telemetry);
+
+/* ========== Constants ========== */
+
+#define FRAME_HOST_QUEUE_SIZE       CONFIG_TELEMETRY_HOST_FILE_QUEUE_SIZE
+#define FRAME_HOST_STACK_SIZE       1536
+#define FRAME_HOST_BATCH_SIZE       CONFIG_TELEMETRY_HOST_FILE_BATCH_BYTES
+
+BUILD_ASSERT(FRAME_HOST_BATCH_SIZE >= FRAME_BATCH_HDR_SIZE + FRAME_BATCH_RECORD_MAX,
+             "CONFIG_TELEMETRY_HOST_FILE_BATCH_BYTES too small for one frame");
+
+/* ========== Global Variables ========== */
+
+/* Aggregator -> writer thread frame pointers; overflow rejects and counts the newest frame */
+FRAME_CONSUMER_DEFINE(frame_host_consumer, FRAME_HOST_QUEUE_SIZE, FRAME_DROP_NEWEST, TELEMETRY_QUEUE_HOST,
+                      EDF_HOST);
+
+K_THREAD_STACK_DEFINE(frame_host_stack, FRAME_HOST_STACK_SIZE);
+struct k_thread frame_host_thread;
+
+/* Writer thread only, except host_batched which the STATUS line reads */
+static uint8_t host_block[FRAME_HOST_BATCH_SIZE];
+TELEMETRY_FOOTPRINT_DEFINE(host_block, "host batch", sizeof(host_block));
+static struct frame_batch host_batch;
+static atomic_t host_batched;
+static int host_fd = -1;
+static char *host_path = CONFIG_TELEMETRY_HOST_FILE_PATH;
+
+/* ========== Writer Functions ========== */
+
+static void write_batch(void)
+{
+    uint16_t count = frame_batch_count(&host_batch);
+
+    if (count == 0) {
+        return;
+    }
+
+    size_t len = frame_batch_finish(&host_batch);
+
+    if (frame_host_native_write(host_fd, host_block, len) != 0) {
+        queue_stats_drop_many(TELEMETRY_QUEUE_HOST, count);
+        LOG_DBG("Frame file write failed");
+    }
+
+    frame_batch_init(&host_batch, host_block, sizeof(host_block));
+    atomic_set(&host_batched, 0);
+}
+
+/*
+ * The writer thread appends a batch to the file whenever the next frame would not fit. Simulated time
+ * does not advance while host code runs, so writing never costs the data path a deadline.
+ */
+static void frame_host_thread_func(void *arg1, void *arg2, void *arg3)
+{
+    ARG_UNUSED(arg1);
+    ARG_UNUSED(arg2);
+    ARG_UNUSED(arg3);
+
+    struct telemetry_frame *frame;
+
+    frame_batch_init(&host_batch, host_block, sizeof(host_block));
+
+    LOG_INF("Host file sink writing to %s", host_path);
+
+    while (1) {
+        frame = frame_consumer_get(&frame_host_consumer, K_FOREVER);
+        if (frame == NULL) {
+            continue;
+        }
+        atomic_set(&host_batched, frame_batch_push(&host_batch, frame, write_batch));
+        edf_done(EDF_HOST);
+    }
+}
+
+/* --telemetry_out=<path> overrides CONFIG_TELEMETRY_HOST_FILE_PATH */
+static void frame_host_add_options(void)
+{
+    static struct args_struct_t frame_host_options[] = {
+        {
+            .option = "telemetry_out",
+            .name = "path",
+            .type = 's',
+            .dest = (void *)&host_path,
+            .descript = "Host file that receives the telemetry frame batches",
+        },
+        ARG_TABLE_ENDMARKER
+    };
+
+    native_add_command_line_opts(frame_host_options);
+}
+
+NATIVE_TASK(frame_host_add_options, PRE_BOOT_1, 10);
+
+/*
+ * --stop_at ends the run between simulated time steps, while every thread waits, so the writer is
+ * blocked in frame_consumer_get() and the open batch is consistent.
+ */
+static void frame_host_on_exit(void)
+{
+    if (host_fd < 0) {
+        return;
+    }
+    write_batch();
+    frame_host_native_close(host_fd);
+    host_fd = -1;
+}
+
+NATIVE_TASK(frame_host_on_exit, ON_EXIT, 10);
+
+int frame_host_init(void)
+{
+    /* Without a file the sink stays unregistered, so no frame is queued for a thread that never runs */
+    host_fd = frame_host_native_open(host_path);
+    if (host_fd < 0) {
+        LOG_ERR("Cannot create frame file %s", host_path);
+        return -EIO;
+    }
+
+    frame_pool_register(&frame_host_consumer);
+
+    k_thread_create(&frame_host_thread, frame_host_stack,
+                    K_THREAD_STACK_SIZEOF(frame_host_stack),
+                    frame_host_thread_func, NULL, NULL, NULL,
+                    PRIO_HOST_FILE, 0, K_FOREVER);
+    k_thread_name_set(&frame_host_thread, "host_file");
+    edf_register(&frame_host_thread, PRIO_HOST_FILE, BIT(EDF_HOST));
+    cpu_affinity_register(&frame_host_thread, CPU_ROLE_SINK, 0);
+    k_thread_start(&frame_host_thread);
+
+    return 0;
+}
+
+uint32_t frame_host_backlog(void)
+{
+    return frame_consumer_backlog(&frame_host_consumer) + (uint32_t)atomic_get(&host_batched);
+}
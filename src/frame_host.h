@@ -0,0 +1,28 @@
+#ifndef FRAME_HOST_H_
+#define FRAME_HOST_H_
+
+#include <stdint.h>
+
+#include "telemetry.h"
+
+/*
+ * Host file frame sink (CONFIG_TELEMETRY_HOST_FILE, native_sim only).
+ *
+ * The sink is a frame pool consumer (frame_pool.h). A low priority writer thread packs the frames it
+ * receives into frame_batch blocks (frame_codec.h) of CONFIG_TELEMETRY_HOST_FILE_BATCH_BYTES and appends
+ * each full block to a file on the host, the same unit the flash log and the UDP sink use. Batches
+ * carry their own length, so the file is a plain concatenation of them and every batch decodes on its
+ * own. The file is CONFIG_TELEMETRY_HOST_FILE_PATH unless --telemetry_out=<path> is given, and its
+ * last partial batch is written when the simulation exits.
+ */
+
+/*
+ * Opens the host file, then registers the sink as a frame consumer and creates the writer thread.
+ * Returns 0, or -EIO when the file cannot be created and the sink stays off.
+ */
+int frame_host_init(void);
+
+/* Frames queued or batched but not written yet */
+uint32_t frame_host_backlog(void);
+
+#endif /* FRAME_HOST_H_ */
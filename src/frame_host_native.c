@@ -0,0 +1,37 @@
+/* Built with the host C library into the native_sim runner, see frame_host_native.h */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "frame_host_native.h"
+
+int frame_host_native_open(const char *path)
+{
+    return open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
+int frame_host_native_write(int fd, const void *buf, unsigned long len)
+{
+    const char *pos = buf;
+
+    while (len > 0) {
+        ssize_t written = write(fd, pos, len);
+
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        pos += written;
+        len -= (unsigned long)written;
+    }
+
+    return 0;
+}
+
+void frame_host_native_close(int fd)
+{
+    (void)close(fd);
+}
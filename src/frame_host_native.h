@@ -0,0 +1,17 @@
+#ifndef FRAME_HOST_NATIVE_H_
+#define FRAME_HOST_NATIVE_H_
+
+/*
+ * Host side of the host file sink. frame_host_native.c is built into the native_sim runner against
+ * the host C library, so only plain C types cross this interface.
+ */
+
+/* Creates or truncates path. Returns a descriptor, or a negative value on error. */
+int frame_host_native_open(const char *path);
+
+/* Writes all len bytes. Returns 0, or a negative value on error. */
+int frame_host_native_write(int fd, const void *buf, unsigned long len);
+
+void frame_host_native_close(int fd);
+
+#endif /* FRAME_HOST_NATIVE_H_ */
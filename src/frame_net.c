@@ -0,0 +1,152 @@
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+
+#include "frame_net.h"
+#include "frame_codec.h"
+#include "frame_pool.h"
+#include "queue_stats.h"
+#include "footprint.h"
+#include "cpu_affinity.h"
+#include "sched_edf.h"
+
+LOG_MODULE_DECLARE(telemetry);
+
+/* ========== Constants ========== */
+
+#define FRAME_NET_QUEUE_SIZE        CONFIG_TELEMETRY_NET_QUEUE_SIZE
+#define FRAME_NET_OVERFLOW          COND_CODE_1(CONFIG_TELEMETRY_NET_DROP_OLDEST, (FRAME_DROP_OLDEST), (FRAME_DROP_NEWEST))
+#define FRAME_NET_STACK_SIZE        1536
+#define FRAME_NET_DATAGRAM_SIZE     CONFIG_TELEMETRY_NET_BATCH_BYTES
+
+BUILD_ASSERT(FRAME_NET_DATAGRAM_SIZE >= FRAME_BATCH_HDR_SIZE + FRAME_BATCH_RECORD_MAX,
+             "CONFIG_TELEMETRY_NET_BATCH_BYTES too small for one frame");
+
+/* ========== Global Variables ========== */
+
+/* Aggregator -> sender thread frame pointers */
+FRAME_CONSUMER_DEFINE(frame_net_consumer, FRAME_NET_QUEUE_SIZE, FRAME_NET_OVERFLOW, TELEMETRY_QUEUE_NET,
+                      EDF_NET);
+
+K_THREAD_STACK_DEFINE(frame_net_stack, FRAME_NET_STACK_SIZE);
+struct k_thread frame_net_thread;
+
+/* Sender thread only, except net_batched which the STATUS line reads */
+static uint8_t net_datagram[FRAME_NET_DATAGRAM_SIZE];
+TELEMETRY_FOOTPRINT_DEFINE(net_datagram, "net datagram", sizeof(net_datagram));
+static struct frame_batch net_batch;
+static atomic_t net_batched;
+static int net_socket = -1;
+static struct sockaddr_in net_peer;
+
+/* ========== Sender Functions ========== */
+
+static void send_batch(void)
+{
+    uint16_t count = frame_batch_count(&net_batch);
+
+    if (count == 0) {
+        return;
+    }
+
+    size_t len = frame_batch_finish(&net_batch);
+
+    if (zsock_sendto(net_socket, net_datagram, len, 0,
+                     (struct sockaddr *)&net_peer, sizeof(net_peer)) < 0) {
+        queue_stats_drop_many(TELEMETRY_QUEUE_NET, count);
+        LOG_DBG("Frame datagram send failed (%d)", errno);
+    }
+
+    frame_batch_init(&net_batch, net_datagram, sizeof(net_datagram));
+    atomic_set(&net_batched, 0);
+}
+
+static int open_socket(void)
+{
+    net_peer.sin_family = AF_INET;
+    net_peer.sin_port = htons(CONFIG_TELEMETRY_NET_PEER_PORT);
+    if (zsock_inet_pton(AF_INET, CONFIG_TELEMETRY_NET_PEER_ADDR, &net_peer.sin_addr) != 1) {
+        LOG_ERR("Invalid frame sink address %s", CONFIG_TELEMETRY_NET_PEER_ADDR);
+        return -EINVAL;
+    }
+
+    net_socket = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (net_socket < 0) {
+        LOG_ERR("Frame sink socket failed (%d)", errno);
+        return -errno;
+    }
+
+    return 0;
+}
+
+/*
+ * The sender thread batches frames and sends them. It sleeps until a frame arrives or the open batch
+ * reaches its flush time, so an idle link costs no wakeups.
+ */
+static void frame_net_thread_func(void *arg1, void *arg2, void *arg3)
+{
+    ARG_UNUSED(arg1);
+    ARG_UNUSED(arg2);
+    ARG_UNUSED(arg3);
+
+    struct telemetry_frame *frame;
+    int64_t flush_at = 0;
+
+    frame_batch_init(&net_batch, net_datagram, sizeof(net_datagram));
+
+    LOG_INF("Network sink thread started");
+
+    while (1) {
+        k_timeout_t timeout = frame_batch_count(&net_batch) == 0 ? K_FOREVER : K_TIMEOUT_ABS_MS(flush_at);
+
+        frame = frame_consumer_get(&frame_net_consumer, timeout);
+        if (frame != NULL) {
+            /* Byte threshold: a frame that does not fit sends the datagram and opens the next one */
+            uint16_t count = frame_batch_push(&net_batch, frame, send_batch);
+
+            if (count == 1) {
+                flush_at = k_uptime_get() + CONFIG_TELEMETRY_NET_FLUSH_MS;
+            }
+            atomic_set(&net_batched, count);
+
+            if (count >= CONFIG_TELEMETRY_NET_BATCH_FRAMES) {
+                send_batch();
+            }
+            edf_done(EDF_NET);
+        }
+
+        if (frame_batch_count(&net_batch) > 0 && k_uptime_get() >= flush_at) {
+            send_batch();
+        }
+    }
+}
+
+int frame_net_init(void)
+{
+    /* Without a socket the sink stays unregistered, so no frame is queued for a thread that never runs */
+    int rc = open_socket();
+
+    if (rc != 0) {
+        return rc;
+    }
+
+    frame_pool_register(&frame_net_consumer);
+
+    k_thread_create(&frame_net_thread, frame_net_stack,
+                    K_THREAD_STACK_SIZEOF(frame_net_stack),
+                    frame_net_thread_func, NULL, NULL, NULL,
+                    PRIO_NET, 0, K_FOREVER);
+    k_thread_name_set(&frame_net_thread, "net");
+    edf_register(&frame_net_thread, PRIO_NET, BIT(EDF_NET));
+    cpu_affinity_register(&frame_net_thread, CPU_ROLE_SINK, 0);
+    k_thread_start(&frame_net_thread);
+
+    return 0;
+}
+
+uint32_t frame_net_backlog(void)
+{
+    return frame_consumer_backlog(&frame_net_consumer) + (uint32_t)atomic_get(&net_batched);
+}
@@ -0,0 +1,27 @@
+#ifndef FRAME_NET_H_
+#define FRAME_NET_H_
+
+#include <stdint.h>
+
+#include "telemetry.h"
+
+/*
+ * UDP frame sink (CONFIG_TELEMETRY_NET).
+ *
+ * The sink is a frame pool consumer (frame_pool.h). A low priority sender thread packs the frames it
+ * receives into a frame_batch (frame_codec.h) and sends it as one datagram once it holds
+ * CONFIG_TELEMETRY_NET_BATCH_FRAMES frames, would exceed CONFIG_TELEMETRY_NET_BATCH_BYTES, or its
+ * oldest frame is CONFIG_TELEMETRY_NET_FLUSH_MS old. Every datagram starts with a keyframe, so a lost
+ * datagram never affects the next one. Nothing on the frame path touches the network stack.
+ */
+
+/*
+ * Opens the socket, then registers the sink as a frame consumer and creates the sender thread.
+ * Returns 0, or a negative errno when the socket cannot be opened and the sink stays off.
+ */
+int frame_net_init(void);
+
+/* Frames queued or batched but not sent yet */
+uint32_t frame_net_backlog(void);
+
+#endif /* FRAME_NET_H_ */
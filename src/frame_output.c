@@ -0,0 +1,203 @@
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+#if defined(CONFIG_TELEMETRY_OUTPUT_BINARY)
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/sys/crc.h>
+#endif
+#if defined(CONFIG_TELEMETRY_FRAME_CHANNEL)
+#include <zephyr/zbus/zbus.h>
+#endif
+
+#include "frame_output.h"
+#include "frame_pool.h"
+#include "sensor_channel.h"
+#include "latency_stats.h"
+#include "queue_stats.h"
+#include "frame_codec.h"
+#include "rollup.h"
+#include "footprint.h"
+#include "cpu_affinity.h"
+#include "sched_edf.h"
+
+LOG_MODULE_DECLARE(telemetry);
+
+/* ========== Constants ========== */
+
+#define FRAME_OUTPUT_QUEUE_SIZE     16  /* 3.2 s of frames at 5 Hz, must be a power of two */
+#define FRAME_OUTPUT_OVERFLOW       COND_CODE_1(CONFIG_TELEMETRY_OUTPUT_DROP_OLDEST, \
+                                                (FRAME_DROP_OLDEST), (FRAME_DROP_NEWEST))
+#define FRAME_OUTPUT_STACK_SIZE     1024
+
+#define FRAME_RECORD_SYNC           0xA5
+#define FRAME_RECORD_MAX_SIZE       (1 + 2 + FRAME_CODEC_MAX_SIZE + 1)  /* sync, length, payload, CRC-8 */
+
+/* ========== Global Variables ========== */
+
+/* Aggregator (producer) -> output thread (consumer) */
+FRAME_CONSUMER_DEFINE(frame_output_consumer, FRAME_OUTPUT_QUEUE_SIZE, FRAME_OUTPUT_OVERFLOW, TELEMETRY_QUEUE_OUTPUT,
+                      EDF_OUTPUT);
+
+#if defined(CONFIG_TELEMETRY_FRAME_CHANNEL)
+/* Output thread -> any observer; no observers of its own */
+ZBUS_CHAN_DEFINE(frame_chan, struct telemetry_frame, NULL, NULL, ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+#endif
+
+K_THREAD_STACK_DEFINE(frame_output_stack, FRAME_OUTPUT_STACK_SIZE);
+struct k_thread frame_output_thread;
+
+#if defined(CONFIG_TELEMETRY_OUTPUT_BINARY)
+static const struct device *const console_uart = DEVICE_DT_GET(DT_CHOSEN(zephyr_console));
+static struct frame_codec output_codec;  /* owned by the output thread */
+TELEMETRY_FOOTPRINT_DEFINE(output_codec, "output codec", sizeof(output_codec));
+#endif
+
+/* ========== Output Functions ========== */
+
+static void print_frame(const struct telemetry_frame *frame)
+{
+    if (frame->gap) {
+        printk("GAP %u-%u | ts=%lld | slots=%u\n", frame->frame_id,
+               frame->frame_id + frame->slot_count - 1, frame->timestamp, frame->slot_count);
+        return;
+    }
+
+    printk("FRAME %u | ts=%lld | up=%u | sensor=%d | avg=%u | min=%d | max=%d | degraded=%d",
+           frame->frame_id, frame->timestamp, frame->uptime,
+           frame->latest_sensor_value, frame->sensor_avg_last_200ms,
+           frame->sensor_min_last_200ms, frame->sensor_max_last_200ms,
+           frame->degraded ? 1 : 0);
+
+    if (frame->slot_count > 1) {
+        printk(" | slots=%u", frame->slot_count);
+    }
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+    printk(" | sd=%d | p50=%d | p95=%d", frame->channels[0].stddev, frame->channels[0].p50, frame->channels[0].p95);
+#endif
+
+    /* Secondary channels as name=latest/avg/min/max, followed by /stddev/p50/p95 with window stats */
+    for (uint32_t ch = 1; ch < frame->channel_count; ch++) {
+        const struct telemetry_channel_stats *stats = &frame->channels[ch];
+
+        printk(" | %s=%d/%d/%d/%d", telemetry_channel_get(ch)->name,
+               stats->latest, stats->avg, stats->min, stats->max);
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+        printk("/%d/%d/%d", stats->stddev, stats->p50, stats->p95);
+#endif
+    }
+    printk("\n");
+
+#if defined(CONFIG_TELEMETRY_ROLLUP)
+    /* Coarser levels are only reported when they close */
+    for (uint32_t level = 0; level < TELEMETRY_ROLLUP_LEVELS; level++) {
+        const struct telemetry_rollup *bucket = &frame->rollups[level];
+
+        if ((frame->rollup_closed & BIT(level)) == 0 || bucket->count == 0) {
+            continue;
+        }
+        printk("ROLLUP %s | start=%lld | avg=%d | min=%d | max=%d | n=%u\n",
+               rollup_level_name(level), bucket->start, (int32_t)(bucket->sum / bucket->count),
+               bucket->min, bucket->max, bucket->count);
+    }
+#endif
+}
+
+#if defined(CONFIG_TELEMETRY_OUTPUT_BINARY)
+/*
+ * Writes one framed binary record: sync byte, payload length as a one or two byte varint,
+ * the frame_codec payload and a CRC-8 over the payload. Console text that ends up between
+ * records is skipped by the host decoder.
+ */
+static void write_frame_record(const struct telemetry_frame *frame)
+{
+    uint8_t record[FRAME_RECORD_MAX_SIZE];
+    size_t header = 2;
+    size_t len = frame_codec_encode(&output_codec, frame, &record[3], FRAME_CODEC_MAX_SIZE);
+
+    if (len == 0) {
+        return;
+    }
+
+    if (len >= 0x80) {
+        header = 3;
+        record[2] = (uint8_t)(len >> 7);
+    } else {
+        memmove(&record[2], &record[3], len);
+    }
+    record[0] = FRAME_RECORD_SYNC;
+    record[1] = (uint8_t)(len & 0x7f) | (len >= 0x80 ? 0x80 : 0);
+    record[header + len] = crc8_ccitt(0xFF, &record[header], len);
+
+    for (size_t i = 0; i < header + len + 1; i++) {
+        uart_poll_out(console_uart, record[i]);
+    }
+}
+#endif
+
+/*
+ * The output thread is the console frame consumer and reports every frame it receives.
+ * It runs below the aggregator and producer, so formatting and UART time only ever consume idle time
+ * of the data path; if it falls behind for longer than its queue can absorb, frames are dropped and counted.
+ */
+static void frame_output_thread_func(void *arg1, void *arg2, void *arg3)
+{
+    ARG_UNUSED(arg1);
+    ARG_UNUSED(arg2);
+    ARG_UNUSED(arg3);
+
+    struct telemetry_frame *frame;
+
+    LOG_INF("Output thread started");
+
+#if defined(CONFIG_TELEMETRY_OUTPUT_BINARY)
+    frame_codec_init(&output_codec, CONFIG_TELEMETRY_OUTPUT_KEYFRAME_INTERVAL);
+#endif
+
+    while (1) {
+        frame = frame_consumer_get(&frame_output_consumer, K_FOREVER);
+        if (frame == NULL) {
+            continue;
+        }
+#if defined(CONFIG_TELEMETRY_OUTPUT_BINARY)
+        write_frame_record(frame);
+#else
+        print_frame(frame);
+#endif
+#if defined(CONFIG_TELEMETRY_FRAME_CHANNEL)
+        /* Observers only see frames the console has already reported; a busy channel skips one frame */
+        (void)zbus_chan_pub(&frame_chan, frame, K_NO_WAIT);
+#endif
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+        latency_record_since(LATENCY_ASSEMBLED_TO_OUTPUT, frame->assembled_cycles);
+        if (!frame->gap && frame->latest_sensor_value >= 0) {
+            latency_record_since(LATENCY_END_TO_END, frame->sample_isr_cycles);
+        }
+#endif
+        frame_pool_release(frame);
+        edf_done(EDF_OUTPUT);
+    }
+
+    LOG_INF("Output thread stopped");
+}
+
+void frame_output_init(void)
+{
+    frame_pool_register(&frame_output_consumer);
+
+    k_thread_create(&frame_output_thread, frame_output_stack,
+                    K_THREAD_STACK_SIZEOF(frame_output_stack),
+                    frame_output_thread_func, NULL, NULL, NULL,
+                    PRIO_OUTPUT, 0, K_FOREVER);
+    k_thread_name_set(&frame_output_thread, "output");
+    edf_register(&frame_output_thread, PRIO_OUTPUT, BIT(EDF_OUTPUT));
+    cpu_affinity_register(&frame_output_thread, CPU_ROLE_SINK, 0);
+    k_thread_start(&frame_output_thread);
+}
+
+uint32_t frame_output_dropped(void)
+{
+    return queue_stats_drops(TELEMETRY_QUEUE_OUTPUT);
+}
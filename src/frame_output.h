@@ -0,0 +1,37 @@
+#ifndef FRAME_OUTPUT_H_
+#define FRAME_OUTPUT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#if defined(CONFIG_TELEMETRY_FRAME_CHANNEL)
+#include <zephyr/zbus/zbus.h>
+#endif
+
+#include "telemetry.h"
+
+/*
+ * Deferred output stage.
+ *
+ * The console is a frame pool consumer (frame_pool.h): the aggregator publishes finished frames and
+ * returns immediately; a low priority output thread formats and transports them, so console latency
+ * never sits on the frame deadline path.
+ *
+ * With CONFIG_TELEMETRY_FRAME_CHANNEL the output thread also publishes every frame it has written on
+ * frame_chan (struct telemetry_frame). Listeners run in the output thread; subscribers and message
+ * subscribers get their own notification or copy, so none of them delays the aggregator.
+ */
+
+#if defined(CONFIG_TELEMETRY_FRAME_CHANNEL)
+ZBUS_CHAN_DECLARE(frame_chan);
+#endif
+
+/*
+ * Registers the console consumer and creates the output thread.
+ * Must be called before the aggregator produces its first frame.
+ */
+void frame_output_init(void);
+
+/* Number of frames dropped because the output queue was full */
+uint32_t frame_output_dropped(void);
+
+#endif /* FRAME_OUTPUT_H_ */
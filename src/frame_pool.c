@@ -0,0 +1,154 @@
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+
+#include "frame_pool.h"
+#include "frame_rate.h"
+#include "footprint.h"
+
+LOG_MODULE_DECLARE(telemetry);
+
+/* ========== Constants ========== */
+
+#define FRAME_POOL_MAX_CONSUMERS    4
+
+/* ========== Global Variables ========== */
+
+struct frame_block {
+    struct telemetry_frame frame;   /* first member, consumers only ever see this */
+    atomic_t refs;
+};
+
+/* Blocks start a cache line, so a sink reading one frame never shares a line with the next being built */
+#define FRAME_BLOCK_SIZE            ROUND_UP(sizeof(struct frame_block), TELEMETRY_CACHE_LINE)
+
+K_MEM_SLAB_DEFINE_STATIC(frame_slab, FRAME_BLOCK_SIZE, CONFIG_TELEMETRY_FRAME_POOL_SIZE, TELEMETRY_CACHE_LINE);
+TELEMETRY_FOOTPRINT_DEFINE(frame_pool, "frame pool", CONFIG_TELEMETRY_FRAME_POOL_SIZE * FRAME_BLOCK_SIZE);
+
+static struct frame_consumer *frame_consumers[FRAME_POOL_MAX_CONSUMERS];
+static uint32_t frame_consumer_count;
+
+/* ========== Pool Functions ========== */
+
+void frame_pool_register(struct frame_consumer *consumer)
+{
+    if (frame_consumer_count == ARRAY_SIZE(frame_consumers)) {
+        LOG_ERR("Too many frame consumers, %s not registered", consumer->name);
+        return;
+    }
+
+    k_sem_init(&consumer->ready, 0, consumer->mask + 1);
+    frame_consumers[frame_consumer_count++] = consumer;
+}
+
+struct telemetry_frame *frame_pool_alloc(void)
+{
+    struct frame_block *block;
+
+    if (k_mem_slab_alloc(&frame_slab, (void **)&block, K_NO_WAIT) != 0) {
+        queue_stats_drop(TELEMETRY_QUEUE_POOL);
+        return NULL;
+    }
+
+    memset(&block->frame, 0, sizeof(block->frame));
+    queue_stats_depth(TELEMETRY_QUEUE_POOL, k_mem_slab_num_used_get(&frame_slab));
+
+    return &block->frame;
+}
+
+void frame_pool_release(const struct telemetry_frame *frame)
+{
+    struct frame_block *block = CONTAINER_OF(frame, struct frame_block, frame);
+
+    if (atomic_dec(&block->refs) == 1) {
+        k_mem_slab_free(&frame_slab, (void *)block);
+    }
+}
+
+uint32_t frame_pool_used(void)
+{
+    return k_mem_slab_num_used_get(&frame_slab);
+}
+
+/*
+ * Consumer side. Pops the oldest queued frame. A drop-oldest publisher also advances head, so the
+ * slot is only owned by whoever wins the CAS; a consumer that loses retries with the new head.
+ */
+static struct telemetry_frame *consumer_pop(struct frame_consumer *consumer)
+{
+    while (1) {
+        uint32_t head = (uint32_t)atomic_get(&consumer->head);
+
+        if (head == (uint32_t)atomic_get(&consumer->tail)) {
+            return NULL;
+        }
+
+        struct telemetry_frame *frame = consumer->slots[head & consumer->mask];
+
+        if (atomic_cas(&consumer->head, (atomic_val_t)head, (atomic_val_t)(head + 1))) {
+            return frame;
+        }
+    }
+}
+
+/* Publisher side. Returns false when the frame was not queued. */
+static bool consumer_push(struct frame_consumer *consumer, struct telemetry_frame *frame)
+{
+    uint32_t tail = (uint32_t)atomic_get(&consumer->tail);
+    uint32_t head = (uint32_t)atomic_get(&consumer->head);
+
+    if (tail - head > consumer->mask) {
+        if (consumer->overflow == FRAME_DROP_NEWEST) {
+            return false;
+        }
+
+        /*
+         * Make room with one CAS on the observed head. Only the publisher writes slots, so the frame
+         * read here is still the oldest one; losing the CAS means the consumer took it and made room.
+         */
+        struct telemetry_frame *oldest = consumer->slots[head & consumer->mask];
+
+        if (atomic_cas(&consumer->head, (atomic_val_t)head, (atomic_val_t)(head + 1))) {
+            queue_stats_drop(consumer->queue);
+            edf_drop(consumer->activity);
+            frame_pool_release(oldest);
+        }
+    }
+
+    consumer->slots[tail & consumer->mask] = frame;
+    atomic_set(&consumer->tail, (atomic_val_t)(tail + 1));
+    /* Released before the give, so the sink wakes up with this frame's deadline */
+    edf_release(consumer->activity, frame_rate_period_ms());
+    k_sem_give(&consumer->ready);
+    queue_stats_depth(consumer->queue, tail + 1 - (uint32_t)atomic_get(&consumer->head));
+
+    return true;
+}
+
+void frame_pool_publish(struct telemetry_frame *frame)
+{
+    struct frame_block *block = CONTAINER_OF(frame, struct frame_block, frame);
+
+    /* One reference per consumer plus the publisher's, so the frame outlives the fan-out loop */
+    atomic_set(&block->refs, (atomic_val_t)(frame_consumer_count + 1));
+
+    for (uint32_t i = 0; i < frame_consumer_count; i++) {
+        if (!consumer_push(frame_consumers[i], frame)) {
+            queue_stats_drop(frame_consumers[i]->queue);
+            frame_pool_release(frame);
+        }
+    }
+
+    frame_pool_release(frame);
+}
+
+struct telemetry_frame *frame_consumer_get(struct frame_consumer *consumer, k_timeout_t timeout)
+{
+    if (k_sem_take(&consumer->ready, timeout) != 0) {
+        return NULL;
+    }
+
+    /* One give per queued frame; NULL when the frame was dropped as the oldest meanwhile */
+    return consumer_pop(consumer);
+}
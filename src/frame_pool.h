@@ -0,0 +1,96 @@
+#ifndef FRAME_POOL_H_
+#define FRAME_POOL_H_
+
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#include "telemetry.h"
+#include "queue_stats.h"
+#include "sched_edf.h"
+#include "footprint.h"
+
+/*
+ * Zero-copy frame fan-out.
+ *
+ * The aggregator builds every frame in place in a block of a k_mem_slab pool and publishes a pointer
+ * to it to every registered consumer. Each consumer gets the pointer through its own lock-free ring;
+ * the frame carries one reference per consumer and goes back to the pool when the last consumer
+ * releases it. A frame is never copied after the aggregator has filled it.
+ *
+ * A full consumer ring either rejects the new frame (drop-newest) or gives up its oldest queued frame
+ * to make room (drop-oldest), counted as drops of the consumer's queue. The pool must hold more frames
+ * than all consumer rings together, or a stalled drop-newest consumer can starve the aggregator.
+ *
+ * Publishing also releases the consumer's EDF job for the frame, and dropping its oldest frame ends
+ * that frame's job as missed, so a sink thread is always ready with the deadline of its oldest frame.
+ */
+
+enum frame_overflow {
+    FRAME_DROP_NEWEST,
+    FRAME_DROP_OLDEST,
+};
+
+struct frame_consumer {
+    const char *name;
+    struct telemetry_frame **slots;
+    uint32_t mask;
+    atomic_t head;      /* advanced by the consumer, and by the publisher when dropping the oldest */
+    atomic_t tail;      /* written by the publisher only */
+    enum frame_overflow overflow;
+    enum telemetry_queue queue;     /* drop accounting */
+    enum edf_activity activity;     /* job released per published frame */
+    struct k_sem ready;
+};
+
+#define FRAME_CONSUMER_DEFINE(_name, _depth, _overflow, _queue, _activity)                      \
+    BUILD_ASSERT(IS_POWER_OF_TWO(_depth), "frame consumer depth must be a power of two");      \
+    static struct telemetry_frame *_frame_consumer_slots_##_name[_depth];                      \
+    struct frame_consumer _name = {                                                             \
+        .name = #_name,                                                                         \
+        .slots = _frame_consumer_slots_##_name,                                                 \
+        .mask = (_depth) - 1,                                                                   \
+        .head = ATOMIC_INIT(0),                                                                 \
+        .tail = ATOMIC_INIT(0),                                                                 \
+        .overflow = (_overflow),                                                                \
+        .queue = (_queue),                                                                      \
+        .activity = (_activity),                                                                \
+    };                                                                                          \
+    TELEMETRY_FOOTPRINT_DEFINE(_name, #_name,                                                   \
+                               sizeof(_frame_consumer_slots_##_name) + sizeof(struct frame_consumer))
+
+/* Adds a consumer. Must be called before the first frame is published. */
+void frame_pool_register(struct frame_consumer *consumer);
+
+/* Returns a zeroed frame, or NULL and counts a pool drop when every block is in use. Never blocks. */
+struct telemetry_frame *frame_pool_alloc(void);
+
+/* Hands the frame to every consumer. The publisher must not touch it afterwards. */
+void frame_pool_publish(struct telemetry_frame *frame);
+
+/* Drops one reference; the last one returns the frame to the pool */
+void frame_pool_release(const struct telemetry_frame *frame);
+
+/* Frames currently allocated */
+uint32_t frame_pool_used(void);
+
+/*
+ * Consumer side. Returns the oldest queued frame, to be released with frame_pool_release(). Returns NULL
+ * on timeout, after frame_consumer_wake(), or when the frame it woke up for was dropped as the oldest.
+ */
+struct telemetry_frame *frame_consumer_get(struct frame_consumer *consumer, k_timeout_t timeout);
+
+/* Wakes a consumer blocked in frame_consumer_get() without a frame */
+static inline void frame_consumer_wake(struct frame_consumer *consumer)
+{
+    k_sem_give(&consumer->ready);
+}
+
+/* Frames queued for the consumer */
+static inline uint32_t frame_consumer_backlog(struct frame_consumer *consumer)
+{
+    return (uint32_t)atomic_get(&consumer->tail) - (uint32_t)atomic_get(&consumer->head);
+}
+
+#endif /* FRAME_POOL_H_ */
@@ -0,0 +1,115 @@
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+
+#include "telemetry.h"
+#include "frame_rate.h"
+
+LOG_MODULE_DECLARE(telemetry);
+
+/* ========== Constants ========== */
+
+#define ADAPT_HIGH_PCT              75  /* busy time above this share of the period counts as overload */
+#define ADAPT_LOW_PCT               25  /* busy time below this share of the longer period counts as idle */
+#define ADAPT_FRAMES                5   /* consecutive frames needed before the period is stepped */
+
+/* ========== Global Variables ========== */
+
+static atomic_t requested_period_ms = ATOMIC_INIT(TELEMETRY_FRAME_RATE_MS);
+
+/* Written by the aggregator only */
+static atomic_t active_period_ms = ATOMIC_INIT(TELEMETRY_FRAME_RATE_MS);
+static uint32_t applied_request_ms = TELEMETRY_FRAME_RATE_MS;
+
+#if defined(CONFIG_TELEMETRY_FRAME_RATE_ADAPTIVE)
+static uint32_t overload_frames;
+static uint32_t idle_frames;
+#endif
+
+/* ========== Frame Rate Functions ========== */
+
+int frame_rate_set(uint32_t period_ms)
+{
+    if (period_ms < FRAME_RATE_MIN_MS || period_ms > CONFIG_TELEMETRY_FRAME_RATE_MAX_MS) {
+        return -EINVAL;
+    }
+
+    atomic_set(&requested_period_ms, (atomic_val_t)period_ms);
+
+    return 0;
+}
+
+uint32_t frame_rate_requested_ms(void)
+{
+    return (uint32_t)atomic_get(&requested_period_ms);
+}
+
+uint32_t frame_rate_period_ms(void)
+{
+    return (uint32_t)atomic_get(&active_period_ms);
+}
+
+#if defined(CONFIG_TELEMETRY_FRAME_RATE_ADAPTIVE)
+/*
+ * Steps the period by a factor of two with hysteresis: ADAPT_FRAMES overloaded frames in a row slow
+ * down, ADAPT_FRAMES frames in a row that would stay below ADAPT_LOW_PCT at half the period speed up.
+ */
+static uint32_t adapt_period(uint32_t period, uint32_t floor, uint32_t busy_us, bool deadline_met)
+{
+    uint32_t period_us = period * 1000U;
+
+    if (!deadline_met || busy_us * 100U > period_us * ADAPT_HIGH_PCT) {
+        idle_frames = 0;
+        if (++overload_frames >= ADAPT_FRAMES && period < CONFIG_TELEMETRY_FRAME_RATE_MAX_MS) {
+            overload_frames = 0;
+            return MIN(period * 2U, CONFIG_TELEMETRY_FRAME_RATE_MAX_MS);
+        }
+    } else if (period > floor && busy_us * 100U < (period_us / 2U) * ADAPT_LOW_PCT) {
+        overload_frames = 0;
+        if (++idle_frames >= ADAPT_FRAMES) {
+            idle_frames = 0;
+            return MAX(period / 2U, floor);
+        }
+    } else {
+        overload_frames = 0;
+        idle_frames = 0;
+    }
+
+    return period;
+}
+#endif
+
+bool frame_rate_update(uint32_t busy_us, bool deadline_met)
+{
+    uint32_t period = frame_rate_period_ms();
+    uint32_t requested = frame_rate_requested_ms();
+    uint32_t next = period;
+
+    if (requested != applied_request_ms) {
+        /* An explicit request overrides any adaptive step */
+        applied_request_ms = requested;
+        next = requested;
+#if defined(CONFIG_TELEMETRY_FRAME_RATE_ADAPTIVE)
+        overload_frames = 0;
+        idle_frames = 0;
+#endif
+    }
+#if defined(CONFIG_TELEMETRY_FRAME_RATE_ADAPTIVE)
+    else {
+        next = adapt_period(period, requested, busy_us, deadline_met);
+    }
+#else
+    ARG_UNUSED(busy_us);
+    ARG_UNUSED(deadline_met);
+#endif
+
+    if (next == period) {
+        return false;
+    }
+
+    LOG_INF("Frame period %u -> %u ms", period, next);
+    atomic_set(&active_period_ms, (atomic_val_t)next);
+
+    return true;
+}
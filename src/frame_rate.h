@@ -0,0 +1,38 @@
+#ifndef FRAME_RATE_H_
+#define FRAME_RATE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Runtime frame period control.
+ *
+ * Any thread may request a new period with frame_rate_set(). The aggregator owns its timer and
+ * picks the request up at its next wakeup through frame_rate_update(), so the timer is only ever
+ * restarted from the aggregator thread.
+ *
+ * With CONFIG_TELEMETRY_FRAME_RATE_ADAPTIVE the aggregator also reports the busy time of every
+ * frame. Sustained busy time near the period doubles the period (up to
+ * CONFIG_TELEMETRY_FRAME_RATE_MAX_MS); sustained low busy time halves it again, never below the
+ * requested period.
+ */
+
+/* Requests a new frame period. Returns -EINVAL outside [FRAME_RATE_MIN_MS, CONFIG_TELEMETRY_FRAME_RATE_MAX_MS]. */
+int frame_rate_set(uint32_t period_ms);
+
+/* Period requested through frame_rate_set(), or the Kconfig default */
+uint32_t frame_rate_requested_ms(void);
+
+/* Period the aggregator timer currently runs at */
+uint32_t frame_rate_period_ms(void);
+
+/*
+ * Aggregator side. Called once per frame with the wall-clock busy time of the previous frame
+ * (wakeup to hand-over, preemption included) and whether its deadline was met.
+ * Returns true when the timer has to be restarted with frame_rate_period_ms().
+ */
+bool frame_rate_update(uint32_t busy_us, bool deadline_met);
+
+#define FRAME_RATE_MIN_MS           20
+
+#endif /* FRAME_RATE_H_ */
@@ -0,0 +1,256 @@
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fcb.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+
+#include "frame_store.h"
+#include "frame_codec.h"
+#include "frame_pool.h"
+#include "queue_stats.h"
+#include "footprint.h"
+#include "cpu_affinity.h"
+#include "sched_edf.h"
+
+LOG_MODULE_DECLARE(telemetry);
+
+/* ========== Constants ========== */
+
+#define FRAME_STORE_PARTITION       FIXED_PARTITION_ID(storage_partition)
+#define FRAME_STORE_MAGIC           0x544c4d31  /* "TLM1" */
+#define FRAME_STORE_STACK_SIZE      1536
+#define FRAME_STORE_PAGE_SIZE       CONFIG_TELEMETRY_FRAME_STORE_PAGE_SIZE
+#define FRAME_STORE_QUEUE_SIZE      CONFIG_TELEMETRY_FRAME_STORE_QUEUE_SIZE
+#define FRAME_STORE_OVERFLOW        COND_CODE_1(CONFIG_TELEMETRY_FRAME_STORE_DROP_OLDEST, \
+                                                (FRAME_DROP_OLDEST), (FRAME_DROP_NEWEST))
+
+BUILD_ASSERT(FRAME_STORE_PAGE_SIZE >= FRAME_BATCH_HDR_SIZE + FRAME_BATCH_RECORD_MAX,
+             "CONFIG_TELEMETRY_FRAME_STORE_PAGE_SIZE too small for one frame");
+BUILD_ASSERT(FRAME_STORE_PAGE_SIZE < 0x4000, "record length varint limited to two bytes");
+
+/* ========== Global Variables ========== */
+
+/* Aggregator -> store thread frame pointers; frames wait here while a page is written */
+FRAME_CONSUMER_DEFINE(frame_store_consumer, FRAME_STORE_QUEUE_SIZE, FRAME_STORE_OVERFLOW, TELEMETRY_QUEUE_STORE,
+                      EDF_STORE);
+
+/* RAM page, store thread only */
+static uint8_t store_page[FRAME_STORE_PAGE_SIZE];
+static struct frame_batch store_batch;
+static atomic_t store_flush_requested;
+
+static struct flash_sector store_sectors[CONFIG_TELEMETRY_FRAME_STORE_MAX_SECTORS];
+TELEMETRY_FOOTPRINT_DEFINE(store_page, "store page", sizeof(store_page) + sizeof(store_sectors));
+static struct fcb store_fcb;
+
+K_THREAD_STACK_DEFINE(frame_store_stack, FRAME_STORE_STACK_SIZE);
+struct k_thread frame_store_thread;
+
+/* ========== Flash Functions ========== */
+
+static int write_page(void)
+{
+    struct fcb_entry entry;
+    uint16_t len = ROUND_UP(frame_batch_finish(&store_batch), store_fcb.f_align);  /* tail padding to the write block */
+    int rc;
+
+    rc = fcb_append(&store_fcb, len, &entry);
+    if (rc == -ENOSPC) {
+        /* Log full: drop the oldest sector */
+        rc = fcb_rotate(&store_fcb);
+        if (rc == 0) {
+            rc = fcb_append(&store_fcb, len, &entry);
+        }
+    }
+    if (rc != 0) {
+        return rc;
+    }
+
+    rc = flash_area_write(store_fcb.fap, FCB_ENTRY_FA_DATA_OFF(entry), store_page, len);
+    if (rc != 0) {
+        return rc;
+    }
+
+    return fcb_append_finish(&store_fcb, &entry);
+}
+
+/* Writes the page if it holds any frame and starts the next one */
+static void flush_page(void)
+{
+    uint16_t count = frame_batch_count(&store_batch);
+
+    if (count == 0) {
+        return;
+    }
+
+    int rc = write_page();
+
+    if (rc != 0) {
+        queue_stats_drop_many(TELEMETRY_QUEUE_STORE, count);
+        LOG_ERR("Frame store write failed (%d)", rc);
+    }
+
+    frame_batch_init(&store_batch, store_page, sizeof(store_page));
+}
+
+/*
+ * The store thread collects frames into the RAM page and writes each full page as one FCB entry, or a
+ * partial one CONFIG_TELEMETRY_FRAME_STORE_FLUSH_MS after its first frame. It runs below the output thread, so flash program and erase times only delay the store's own
+ * consumer queue, never a frame or the console.
+ */
+static void frame_store_thread_func(void *arg1, void *arg2, void *arg3)
+{
+    ARG_UNUSED(arg1);
+    ARG_UNUSED(arg2);
+    ARG_UNUSED(arg3);
+
+    struct telemetry_frame *frame;
+    int64_t flush_at = 0;
+
+    LOG_INF("Frame store thread started");
+
+    frame_batch_init(&store_batch, store_page, sizeof(store_page));
+
+    while (1) {
+        k_timeout_t timeout = frame_batch_count(&store_batch) == 0 ? K_FOREVER : K_TIMEOUT_ABS_MS(flush_at);
+
+        frame = frame_consumer_get(&frame_store_consumer, timeout);
+        if (frame != NULL) {
+            /* Page full: the frame becomes the keyframe of the next page */
+            if (frame_batch_push(&store_batch, frame, flush_page) == 1) {
+                flush_at = k_uptime_get() + CONFIG_TELEMETRY_FRAME_STORE_FLUSH_MS;
+            }
+            edf_done(EDF_STORE);
+        }
+
+        if (atomic_clear(&store_flush_requested) ||
+            (frame_batch_count(&store_batch) > 0 && k_uptime_get() >= flush_at)) {
+            flush_page();
+        }
+    }
+}
+
+void frame_store_flush(void)
+{
+    atomic_set(&store_flush_requested, 1);
+    frame_consumer_wake(&frame_store_consumer);
+}
+
+static int read_page_header(const struct fcb_entry *entry, struct frame_batch_header *hdr)
+{
+    uint8_t buf[FRAME_BATCH_HDR_SIZE];
+
+    if (entry->fe_data_len < sizeof(buf) ||
+        flash_area_read(store_fcb.fap, FCB_ENTRY_FA_DATA_OFF(*entry), buf, sizeof(buf)) != 0) {
+        return -EIO;
+    }
+
+    /* Only the header is read here, so the declared length is checked against the entry */
+    return frame_batch_parse_header(buf, entry->fe_data_len, hdr) == 0 ? 0 : -EIO;
+}
+
+int64_t frame_store_init(void)
+{
+    uint32_t sector_count = ARRAY_SIZE(store_sectors);
+    struct fcb_entry entry = {0};
+    uint32_t newest_id = 0;
+    int rc;
+
+    rc = flash_area_get_sectors(FRAME_STORE_PARTITION, &sector_count, store_sectors);
+    if (rc != 0) {
+        LOG_ERR("Frame store partition unavailable (%d)", rc);
+        return rc;
+    }
+
+    store_fcb.f_magic = FRAME_STORE_MAGIC;
+    store_fcb.f_version = 1;
+    store_fcb.f_sector_cnt = (uint16_t)sector_count;
+    store_fcb.f_scratch_cnt = 0;
+    store_fcb.f_sectors = store_sectors;
+
+    rc = fcb_init(FRAME_STORE_PARTITION, &store_fcb);
+    if (rc != 0) {
+        LOG_ERR("Frame store mount failed (%d)", rc);
+        return rc;
+    }
+    if (FRAME_STORE_PAGE_SIZE % store_fcb.f_align != 0) {
+        LOG_ERR("Frame store page size not a multiple of the flash write block (%u)", store_fcb.f_align);
+        return -EINVAL;
+    }
+
+    /* Newest entry holds the newest frame_id; one header read per stored page, once at boot */
+    while (fcb_getnext(&store_fcb, &entry) == 0) {
+        struct frame_batch_header hdr;
+
+        if (read_page_header(&entry, &hdr) == 0) {
+            newest_id = hdr.last_id;
+        }
+    }
+
+    frame_pool_register(&frame_store_consumer);
+
+    k_thread_create(&frame_store_thread, frame_store_stack,
+                    K_THREAD_STACK_SIZEOF(frame_store_stack),
+                    frame_store_thread_func, NULL, NULL, NULL,
+                    PRIO_STORE, 0, K_FOREVER);
+    k_thread_name_set(&frame_store_thread, "store");
+    edf_register(&frame_store_thread, PRIO_STORE, BIT(EDF_STORE));
+    cpu_affinity_register(&frame_store_thread, CPU_ROLE_SINK, 0);
+    k_thread_start(&frame_store_thread);
+
+    return newest_id;
+}
+
+/* ========== Read-back ========== */
+
+void frame_store_iter_init(struct frame_store_iter *iter, uint32_t from_id)
+{
+    memset(&iter->entry, 0, sizeof(iter->entry));  /* NULL sector starts at the oldest entry */
+    iter->from_id = from_id;
+    iter->reader.remaining = 0;
+}
+
+/* Loads the next page that reaches from_id. Pages entirely before it are skipped on their header. */
+static int iter_load_page(struct frame_store_iter *iter)
+{
+    struct frame_batch_header hdr;
+
+    while (fcb_getnext(&store_fcb, &iter->entry) == 0) {
+        if (read_page_header(&iter->entry, &hdr) != 0) {
+            return -EIO;
+        }
+        if (hdr.last_id < iter->from_id || hdr.count == 0) {
+            continue;
+        }
+        if (hdr.len > sizeof(iter->page) ||
+            flash_area_read(store_fcb.fap, FCB_ENTRY_FA_DATA_OFF(iter->entry), iter->page, hdr.len) != 0 ||
+            frame_batch_reader_init(&iter->reader, iter->page, hdr.len) != 0) {
+            return -EIO;
+        }
+        return 0;
+    }
+
+    return -ENOENT;
+}
+
+int frame_store_iter_next(struct frame_store_iter *iter, struct telemetry_frame *frame)
+{
+    while (1) {
+        if (iter->reader.remaining == 0) {
+            int rc = iter_load_page(iter);
+
+            if (rc != 0) {
+                return rc;
+            }
+        }
+
+        if (frame_batch_next(&iter->reader, frame) != 0) {
+            return -EIO;  /* corrupt page, the next call continues with the next one */
+        }
+        if (frame->frame_id + MAX(frame->slot_count, 1U) - 1 >= iter->from_id) {
+            return 0;
+        }
+    }
+}
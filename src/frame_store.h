@@ -0,0 +1,52 @@
+#ifndef FRAME_STORE_H_
+#define FRAME_STORE_H_
+
+#include <stdint.h>
+#include <zephyr/fs/fcb.h>
+
+#include "telemetry.h"
+#include "frame_codec.h"
+
+/*
+ * Persistent frame log (CONFIG_TELEMETRY_FRAME_STORE).
+ *
+ * The store is a frame pool consumer (frame_pool.h). Its low priority thread collects frames as a
+ * frame_batch (frame_codec.h) in a RAM page of CONFIG_TELEMETRY_FRAME_STORE_PAGE_SIZE bytes and writes
+ * each full page to the flash circular buffer (FCB) on storage_partition as a single entry, so the
+ * flash sees one write per page instead of one per frame and nothing on the frame path waits for
+ * flash. Frames arriving during a write wait in the consumer queue. A page starts with a keyframe and
+ * decodes on its own. When the log is full the oldest sector is erased. A partial page is written once
+ * its first frame is CONFIG_TELEMETRY_FRAME_STORE_FLUSH_MS old, which bounds the frames lost at a reset.
+ * The telemetry shell reads the log back ("telemetry store").
+ *
+ * frame_id continues from the newest stored frame after a reboot, so it keys the whole log.
+ */
+
+/* Iteration state. Holds one page, so keep it off small stacks. */
+struct frame_store_iter {
+    struct fcb_entry entry;
+    struct frame_batch_reader reader;
+    uint32_t from_id;
+    uint8_t  page[CONFIG_TELEMETRY_FRAME_STORE_PAGE_SIZE];
+};
+
+/*
+ * Mounts the log, registers the frame consumer and starts the store thread. Returns the newest stored
+ * frame_id (0 for an empty log) so the aggregator can continue counting from it, or a negative errno
+ * when the log is unusable.
+ */
+int64_t frame_store_init(void);
+
+/* Asks the store thread to write the partially filled page now, e.g. before a planned reset */
+void frame_store_flush(void);
+
+/*
+ * Starts a read-back at the first stored frame whose slots reach from_id. Safe next to the store
+ * thread; a page erased by a rotation while it is read shows up as -EIO.
+ */
+void frame_store_iter_init(struct frame_store_iter *iter, uint32_t from_id);
+
+/* Returns 0 and the next frame in frame_id order, -ENOENT at the end of the log, or -EIO */
+int frame_store_iter_next(struct frame_store_iter *iter, struct telemetry_frame *frame);
+
+#endif /* FRAME_STORE_H_ */
@@ -0,0 +1,97 @@
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include "latency_stats.h"
+#include "footprint.h"
+
+struct latency_histogram {
+    atomic_t buckets[LATENCY_BUCKETS];
+    atomic_t max;
+};
+
+static struct latency_histogram histograms[LATENCY_STAGE_COUNT];
+TELEMETRY_FOOTPRINT_DEFINE(latency_histograms, "latency histograms", sizeof(histograms));
+
+static const char *const stage_names[LATENCY_STAGE_COUNT] = {
+    [LATENCY_ISR_TO_WORK]         = "isr>work",
+    [LATENCY_TO_ENQUEUE]          = "wake>enq",
+    [LATENCY_ENQUEUE_TO_DEQUEUE]  = "enq>deq",
+    [LATENCY_ASSEMBLED_TO_OUTPUT] = "asm>out",
+    [LATENCY_END_TO_END]          = "e2e",
+};
+
+static inline uint32_t bucket_of(uint32_t cycles)
+{
+    return cycles == 0 ? 0 : 31 - __builtin_clz(cycles);
+}
+
+void latency_record(enum latency_stage stage, uint32_t delta_cycles)
+{
+    struct latency_histogram *hist = &histograms[stage];
+    atomic_val_t max;
+
+    atomic_inc(&hist->buckets[bucket_of(delta_cycles)]);
+
+    do {
+        max = atomic_get(&hist->max);
+        if ((uint32_t)max >= delta_cycles) {
+            break;
+        }
+    } while (!atomic_cas(&hist->max, max, (atomic_val_t)delta_cycles));
+}
+
+/* Upper bound of the bucket that holds the rank-th sample (1-based), in cycles */
+static uint32_t bucket_percentile(const uint32_t *buckets, uint32_t rank)
+{
+    uint32_t seen = 0;
+
+    for (uint32_t b = 0; b < LATENCY_BUCKETS; b++) {
+        seen += buckets[b];
+        if (seen >= rank) {
+            return b == 31 ? UINT32_MAX : (2U << b) - 1;
+        }
+    }
+
+    return UINT32_MAX;
+}
+
+void latency_summarize(enum latency_stage stage, struct latency_summary *summary)
+{
+    struct latency_histogram *hist = &histograms[stage];
+    uint32_t buckets[LATENCY_BUCKETS];
+    uint32_t count = 0;
+    uint32_t max = (uint32_t)atomic_get(&hist->max);
+
+    /* Count from the bucket snapshot itself so the percentiles stay consistent with it */
+    for (uint32_t b = 0; b < LATENCY_BUCKETS; b++) {
+        buckets[b] = (uint32_t)atomic_get(&hist->buckets[b]);
+        count += buckets[b];
+    }
+
+    summary->count = count;
+    if (count == 0) {
+        summary->p50_us = 0;
+        summary->p99_us = 0;
+        summary->max_us = 0;
+        return;
+    }
+
+    summary->p50_us = k_cyc_to_us_floor32(MIN(bucket_percentile(buckets, (count + 1) / 2), max));
+    summary->p99_us = k_cyc_to_us_floor32(MIN(bucket_percentile(buckets, count - count / 100), max));
+    summary->max_us = k_cyc_to_us_floor32(max);
+}
+
+void latency_reset(void)
+{
+    for (int stage = 0; stage < LATENCY_STAGE_COUNT; stage++) {
+        for (int b = 0; b < LATENCY_BUCKETS; b++) {
+            atomic_set(&histograms[stage].buckets[b], 0);
+        }
+        atomic_set(&histograms[stage].max, 0);
+    }
+}
+
+const char *latency_stage_name(enum latency_stage stage)
+{
+    return stage_names[stage];
+}
@@ -0,0 +1,51 @@
+#ifndef LATENCY_STATS_H_
+#define LATENCY_STATS_H_
+
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+/*
+ * Cycle-accurate latency instrumentation of the sensor data path (CONFIG_TELEMETRY_LATENCY_STATS).
+ *
+ * Every hop is stamped with k_cycle_get_32() and the delta to the previous stamp is recorded in a
+ * fixed log2 histogram per stage. Each stage is recorded from a single context, recording is O(1)
+ * and lock-free, and readers take an approximate snapshot without stopping the data path.
+ */
+
+enum latency_stage {
+    LATENCY_ISR_TO_WORK,         /* sensor timer ISR -> work handler (workqueue trigger mode only) */
+    LATENCY_TO_ENQUEUE,          /* work handler, or timer ISR in event mode -> producer enqueue */
+    LATENCY_ENQUEUE_TO_DEQUEUE,  /* producer enqueue -> aggregator dequeue */
+    LATENCY_ASSEMBLED_TO_OUTPUT, /* aggregator finished the frame -> frame output done */
+    LATENCY_END_TO_END,          /* timer ISR of the newest primary sample -> frame output done */
+    LATENCY_STAGE_COUNT,
+};
+
+#define LATENCY_BUCKETS             32  /* bucket b counts deltas in [2^b, 2^(b+1)) cycles */
+
+struct latency_summary {
+    uint32_t count;
+    uint32_t p50_us;    /* upper bound of the bucket holding the percentile, capped at max */
+    uint32_t p99_us;
+    uint32_t max_us;
+};
+
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+
+void latency_record(enum latency_stage stage, uint32_t delta_cycles);
+
+/* Records the cycles elapsed since start_cycles */
+static inline void latency_record_since(enum latency_stage stage, uint32_t start_cycles)
+{
+    latency_record(stage, k_cycle_get_32() - start_cycles);
+}
+
+void latency_summarize(enum latency_stage stage, struct latency_summary *summary);
+
+void latency_reset(void);
+
+const char *latency_stage_name(enum latency_stage stage);
+
+#endif /* CONFIG_TELEMETRY_LATENCY_STATS */
+
+#endif /* LATENCY_STATS_H_ */
@@ -0,0 +1,282 @@
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/logging/log.h>
+
+#include "telemetry.h"
+#include "load_spike.h"
+#include "cpu_affinity.h"
+
+LOG_MODULE_DECLARE(telemetry);
+
+/* ========== Constants ========== */
+
+#define LOAD_SPIKE_STACK_SIZE       1024
+#define LOAD_IDLE_POLL_MS           TELEMETRY_FRAME_RATE_MS  /* re-check period of a profile without load */
+#define LOAD_SIM_STEP_US            1000  /* simulated busy time per work chunk on native_sim */
+#define LOAD_THREAD_NAME_LEN        16
+
+#if defined(CONFIG_SMP)
+#define LOAD_THREADS                CONFIG_MP_MAX_NUM_CPUS
+#else
+#define LOAD_THREADS                1
+#endif
+
+/* ========== Global Variables ========== */
+
+/*
+ * Seeded profiles replay the same load on every boot; the default one unless CONFIG_TELEMETRY_LOAD_SEED
+ * is 0. The bursts range from no load to bursts below and above the producer and above the aggregator.
+ */
+const struct load_profile load_profiles[] = {
+    { .name = "default",    .seed = CONFIG_TELEMETRY_LOAD_SEED, .priority = PRIO_LOAD_SPIKE,
+      .min_interval_ms = CONFIG_NEXT_LOAD_SPIKE_MIN_INTERVAL_MS, .max_interval_ms = CONFIG_NEXT_LOAD_SPIKE_MAX_INTERVAL_MS,
+      .min_duration_ms = CONFIG_LOAD_SPIKE_MIN_DURATION_MS,      .max_duration_ms = CONFIG_LOAD_SPIKE_MAX_DURATION_MS },
+    { .name = "idle",       .seed = 0x00000001, .priority = PRIO_LOAD_SPIKE },
+    { .name = "heavy",      .seed = 0x5eed0002, .priority = PRIO_LOAD_SPIKE,
+      .min_interval_ms = 100, .max_interval_ms = 500,  .min_duration_ms = 50,  .max_duration_ms = 150 },
+    { .name = "below",      .seed = 0x5eed0005, .priority = PRIO_PRODUCER + 1,
+      .min_interval_ms = 200, .max_interval_ms = 1000, .min_duration_ms = 20,  .max_duration_ms = 120 },
+    { .name = "producer",   .seed = 0x5eed0003, .priority = PRIO_PRODUCER - 1,
+      .min_interval_ms = 200, .max_interval_ms = 1000, .min_duration_ms = 20,  .max_duration_ms = 120 },
+    { .name = "aggregator", .seed = 0x5eed0004, .priority = PRIO_AGGREGATOR - 1,
+      .min_interval_ms = 500, .max_interval_ms = 2000, .min_duration_ms = 50,  .max_duration_ms = 250 },
+    { .name = "square",     .shape = LOAD_SHAPE_SQUARE, .seed = 0x5eed0006, .priority = PRIO_LOAD_SPIKE,
+      .period_ms = 1000, .duty_pct = 50 },
+    { .name = "step",       .shape = LOAD_SHAPE_STEP,   .seed = 0x5eed0007, .priority = PRIO_LOAD_SPIKE,
+      .period_ms = 100,  .duty_pct = 10, .end_duty_pct = 80, .ramp_ms = 5000 },
+    { .name = "ramp",       .shape = LOAD_SHAPE_RAMP,   .seed = 0x5eed0008, .priority = PRIO_LOAD_SPIKE,
+      .period_ms = 100,  .duty_pct = 0,  .end_duty_pct = 95, .ramp_ms = 20000 },
+    { .name = "isr",        .shape = LOAD_SHAPE_SQUARE, .target = LOAD_TARGET_ISR, .seed = 0x5eed0009,
+      .priority = PRIO_LOAD_SPIKE, .period_ms = 1000, .duty_pct = 50, .isr_period_us = 500, .isr_busy_us = 200 },
+    { .name = "smp",        .seed = 0x5eed000a, .priority = PRIO_LOAD_SPIKE, .cpus = LOAD_CPUS_ALL,
+      .min_interval_ms = 100, .max_interval_ms = 500,  .min_duration_ms = 50,  .max_duration_ms = 150 },
+};
+
+const uint32_t load_profile_count = ARRAY_SIZE(load_profiles);
+
+K_THREAD_STACK_ARRAY_DEFINE(load_spike_stacks, LOAD_THREADS, LOAD_SPIKE_STACK_SIZE);
+static struct k_thread load_spike_threads[LOAD_THREADS];
+
+static atomic_ptr_t active_profile = ATOMIC_PTR_INIT((void *)&load_profiles[0]);
+
+/* ISR load, armed by the first load thread for the length of a burst */
+static void isr_load_callback(struct k_timer *timer);
+K_TIMER_DEFINE(isr_load_timer, isr_load_callback, NULL);
+static atomic_t isr_busy_us;
+
+/* ========== Load Spike Functions ========== */
+
+static uint32_t pick_in_range(uint32_t *state, uint32_t min, uint32_t max)
+{
+    return max > min ? min + (load_rand(state) % (max - min)) : min;
+}
+
+static void isr_load_callback(struct k_timer *timer)
+{
+    ARG_UNUSED(timer);
+
+    k_busy_wait((uint32_t)atomic_get(&isr_busy_us));
+}
+
+/* Load threads running the profile; the ISR target only needs the first one */
+static uint32_t profile_threads(const struct load_profile *profile)
+{
+    if (profile->target == LOAD_TARGET_ISR) {
+        return 1;
+    }
+    return CLAMP(profile->cpus, 1, LOAD_THREADS);
+}
+
+/* Busy share of the current cycle for SQUARE, STEP and RAMP, elapsed counted from the profile switch */
+static uint32_t shape_duty_pct(const struct load_profile *profile, int64_t elapsed_ms)
+{
+    switch (profile->shape) {
+    case LOAD_SHAPE_STEP:
+        return elapsed_ms < profile->ramp_ms ? profile->duty_pct : profile->end_duty_pct;
+    case LOAD_SHAPE_RAMP:
+        if (elapsed_ms >= profile->ramp_ms) {
+            return profile->end_duty_pct;
+        }
+        return (uint32_t)((int64_t)profile->duty_pct +
+                          ((int64_t)profile->end_duty_pct - profile->duty_pct) * elapsed_ms / profile->ramp_ms);
+    default:
+        return profile->duty_pct;
+    }
+}
+
+/* Draws the next idle and busy time of the profile */
+static void next_cycle(const struct load_profile *profile, uint32_t *rand_state, int64_t elapsed_ms,
+                       uint32_t *idle_ms, uint32_t *busy_ms)
+{
+    if (profile->shape == LOAD_SHAPE_RANDOM) {
+        *idle_ms = pick_in_range(rand_state, profile->min_interval_ms, profile->max_interval_ms);
+        *busy_ms = pick_in_range(rand_state, profile->min_duration_ms, profile->max_duration_ms);
+        return;
+    }
+
+    uint32_t duty = MIN(shape_duty_pct(profile, elapsed_ms), 100U);
+
+    *busy_ms = profile->period_ms * duty / 100U;
+    *idle_ms = profile->period_ms - *busy_ms;
+}
+
+/* Busy-waits in the calling thread for duration_ms */
+static void busy_thread(uint32_t duration_ms, uint32_t *rand_state)
+{
+    int64_t load_spike_start = k_uptime_get();
+    volatile uint32_t dummy = 0;
+
+    while ((k_uptime_get() - load_spike_start) < duration_ms) {
+        /* Perform some meaningless calculations to keep the CPU busy */
+        for (int i = 0; i < 1000; i++) {
+            dummy += load_rand(rand_state);
+        }
+#if defined(CONFIG_ARCH_POSIX)
+        /* native_sim time only advances when told to: charge the chunk as simulated busy time */
+        k_busy_wait(LOAD_SIM_STEP_US);
+#endif
+        /* Small yield to prevent complete system lockup */
+        if ((dummy % 10000) == 0) {
+            k_yield();
+        }
+    }
+}
+
+/* Runs the ISR load for duration_ms; the thread itself only sleeps */
+static void busy_isr(const struct load_profile *profile, uint32_t duration_ms)
+{
+    if (profile->isr_period_us == 0) {
+        return;
+    }
+
+    atomic_set(&isr_busy_us, MIN(profile->isr_busy_us, profile->isr_period_us - 1));
+    k_timer_start(&isr_load_timer, K_USEC(profile->isr_period_us), K_USEC(profile->isr_period_us));
+    k_sleep(K_MSEC(duration_ms));
+    k_timer_stop(&isr_load_timer);
+}
+
+/*
+ * Load spike threads simulate CPU load to test the aggregator's ability to handle scheduling pressure
+ * and maintain frame deadlines.
+ *
+ * The load pattern alternates idle periods with bursts of busy work, as drawn from the active profile,
+ * which can help identify potential issues in the aggregator's scheduling and data processing logic under varying load conditions.
+ * arg1 is the index of the load thread, which is also the CPU it is pinned to on SMP.
+ */
+static void load_spike_generator_thread_func(void *arg1, void *arg2, void *arg3)
+{
+    ARG_UNUSED(arg2);
+    ARG_UNUSED(arg3);
+
+    uint32_t index = (uint32_t)(uintptr_t)arg1;
+    const struct load_profile *profile = NULL;
+    uint32_t rand_state = 1;
+    uint32_t next_load_spike_interval;
+    uint32_t load_spike_burst_duration;
+    int64_t profile_start = 0;
+
+    LOG_INF("Load simulation thread %u started", index);
+
+    while (1) {
+        /* Pick up a profile switch and restart its random sequence and time base */
+        if (atomic_ptr_get(&active_profile) != profile) {
+            profile = atomic_ptr_get(&active_profile);
+            rand_state = profile->seed != 0 ? profile->seed : sys_rand32_get();
+            rand_state = (rand_state ^ (index * 0x9e3779b9U)) | 1U;  /* a distinct sequence per load thread */
+            profile_start = k_uptime_get();
+            k_thread_priority_set(k_current_get(), profile->priority);
+            LOG_DBG("Load profile %s, seed %u", profile->name, profile->seed);
+        }
+
+        if (index >= profile_threads(profile) ||
+            (profile->shape == LOAD_SHAPE_RANDOM && profile->max_duration_ms == 0) ||
+            (profile->shape != LOAD_SHAPE_RANDOM && profile->period_ms == 0)) {
+            k_sleep(K_MSEC(LOAD_IDLE_POLL_MS));
+            continue;
+        }
+
+        next_cycle(profile, &rand_state, k_uptime_get() - profile_start,
+                   &next_load_spike_interval, &load_spike_burst_duration);
+
+        // idle time before next spike (reduce cpu load)
+        if (next_load_spike_interval > 0) {
+            k_sleep(K_MSEC(next_load_spike_interval));
+            if (atomic_ptr_get(&active_profile) != profile) {
+                continue;  /* woken up by a profile switch */
+            }
+        }
+        if (load_spike_burst_duration == 0) {
+            continue;
+        }
+
+        LOG_DBG("After interval of %u ms, executing load spike for %u ms", next_load_spike_interval, load_spike_burst_duration);
+
+        // Simulate scheduling pressure by introducing busy spike time (generate cpu load)
+        if (profile->target == LOAD_TARGET_ISR) {
+            busy_isr(profile, load_spike_burst_duration);
+        } else {
+            busy_thread(load_spike_burst_duration, &rand_state);
+        }
+
+        LOG_DBG("Load spike completed");
+    }
+
+    LOG_INF("Load Spike Generator stopped");
+}
+
+const struct load_profile *load_profile_find(const char *name)
+{
+    for (uint32_t i = 0; i < load_profile_count; i++) {
+        if (strcmp(load_profiles[i].name, name) == 0) {
+            return &load_profiles[i];
+        }
+    }
+
+    return NULL;
+}
+
+const struct load_profile *load_profile_boot(void)
+{
+    const struct load_profile *profile = load_profile_find(CONFIG_TELEMETRY_LOAD_PROFILE);
+
+    return profile != NULL ? profile : &load_profiles[0];
+}
+
+void load_spike_init(void)
+{
+    char name[LOAD_THREAD_NAME_LEN];
+
+    atomic_ptr_set(&active_profile, (void *)load_profile_boot());
+
+    for (uint32_t i = 0; i < LOAD_THREADS; i++) {
+        k_thread_create(&load_spike_threads[i], load_spike_stacks[i],
+                        K_THREAD_STACK_SIZEOF(load_spike_stacks[i]),
+                        load_spike_generator_thread_func, (void *)(uintptr_t)i, NULL, NULL,
+                        PRIO_LOAD_SPIKE, 0, K_FOREVER);
+#if defined(CONFIG_TELEMETRY_CPU_PINNING)
+        /* One load thread per CPU, kept off the data path CPU while the placement is pinned */
+        cpu_affinity_register(&load_spike_threads[i], CPU_ROLE_LOAD, i);
+#elif defined(CONFIG_SMP) && defined(CONFIG_SCHED_CPU_MASK)
+        /* One load thread per CPU, so a multi-core profile loads every core */
+        k_thread_cpu_pin(&load_spike_threads[i], (int)i);
+#endif
+        if (i == 0) {
+            k_thread_name_set(&load_spike_threads[i], "load_spike");
+        } else {
+            snprintk(name, sizeof(name), "load_spike%u", i);
+            k_thread_name_set(&load_spike_threads[i], name);
+        }
+        k_thread_start(&load_spike_threads[i]);
+    }
+}
+
+void load_spike_select_profile(const struct load_profile *profile)
+{
+    atomic_ptr_set(&active_profile, (void *)profile);
+    for (uint32_t i = 0; i < LOAD_THREADS; i++) {
+        k_wakeup(&load_spike_threads[i]);
+    }
+}
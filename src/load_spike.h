@@ -0,0 +1,96 @@
+#ifndef LOAD_SPIKE_H_
+#define LOAD_SPIKE_H_
+
+#include <stdint.h>
+
+/*
+ * Load spike generator.
+ *
+ * Every load thread alternates idle time and busy time as the active load profile dictates. The profiles
+ * live in one static table (load_spike.c):
+ *
+ * - RANDOM draws every idle interval and burst length from a range, the original spike pattern.
+ * - SQUARE, STEP and RAMP run a fixed cycle of period_ms, busy for a duty share of it. SQUARE keeps the
+ *   duty at duty_pct, STEP switches from duty_pct to end_duty_pct after ramp_ms, and RAMP moves linearly
+ *   from one to the other over ramp_ms, counted from the profile switch.
+ *
+ * The busy time is spent either in the load thread itself, at the profile's priority above or below the
+ * data path, or with LOAD_TARGET_ISR in a high-rate timer ISR that busy-waits isr_busy_us of every
+ * isr_period_us while the burst lasts. On SMP one load thread per CPU is pinned to its CPU and the
+ * first cpus of them run the profile (LOAD_CPUS_ALL for all of them). A non-zero seed makes the RANDOM
+ * sequences reproducible: they come from a private xorshift32 generator per load thread instead of
+ * sys_rand32_get().
+ */
+
+#define LOAD_CPUS_ALL               0xFF    /* one load thread per CPU */
+
+enum load_shape {
+    LOAD_SHAPE_RANDOM,
+    LOAD_SHAPE_SQUARE,
+    LOAD_SHAPE_STEP,
+    LOAD_SHAPE_RAMP,
+};
+
+enum load_target {
+    LOAD_TARGET_THREAD,         /* busy-wait in the load thread */
+    LOAD_TARGET_ISR,            /* busy-wait in the load timer ISR, on the first load thread only */
+};
+
+struct load_profile {
+    const char *name;
+    enum load_shape shape;
+    enum load_target target;
+    uint32_t seed;              /* 0: seed from sys_rand32_get(), not reproducible */
+    int      priority;          /* priority of the load threads while the profile is active */
+    uint8_t  cpus;              /* load threads running the profile on SMP, 0 for one, LOAD_CPUS_ALL */
+
+    /* LOAD_SHAPE_RANDOM */
+    uint32_t min_interval_ms;   /* idle time before the next spike */
+    uint32_t max_interval_ms;
+    uint32_t min_duration_ms;   /* busy time of one spike, 0/0 disables load */
+    uint32_t max_duration_ms;
+
+    /* LOAD_SHAPE_SQUARE, LOAD_SHAPE_STEP, LOAD_SHAPE_RAMP */
+    uint32_t period_ms;         /* one busy and idle cycle */
+    uint8_t  duty_pct;          /* busy share of a cycle, the start level of STEP and RAMP */
+    uint8_t  end_duty_pct;      /* level after the step or at the end of the ramp */
+    uint32_t ramp_ms;           /* time of the step, length of the ramp */
+
+    /* LOAD_TARGET_ISR */
+    uint32_t isr_period_us;
+    uint32_t isr_busy_us;       /* must stay below isr_period_us */
+};
+
+/* Static profile table. The first entry is "default", built from the CONFIG_*LOAD_SPIKE* settings. */
+extern const struct load_profile load_profiles[];
+extern const uint32_t load_profile_count;
+
+/* Returns the profile with this name, or NULL */
+const struct load_profile *load_profile_find(const char *name);
+
+/* Profile named by CONFIG_TELEMETRY_LOAD_PROFILE, "default" when that name is unknown */
+const struct load_profile *load_profile_boot(void);
+
+/* Creates the load threads running load_profile_boot() */
+void load_spike_init(void);
+
+/*
+ * Switches the generator to another profile. Sleeping load threads are woken up and every thread
+ * reseeds itself and restarts the profile's time base before drawing the next cycle.
+ */
+void load_spike_select_profile(const struct load_profile *profile);
+
+/* xorshift32 step, state must be non-zero */
+static inline uint32_t load_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return x;
+}
+
+#endif /* LOAD_SPIKE_H_ */
@@ -2,134 +2,263 @@
 #include <zephyr/sys/printk.h>
 #include <zephyr/random/random.h>
 #include <zephyr/logging/log.h>
+#if !defined(CONFIG_TELEMETRY_SENSOR_SINE_LUT)
 #include <math.h>
+#endif
 
-LOG_MODULE_REGISTER(telemetry, LOG_LEVEL_WRN);
-
-/* ========== Data Structures ========== */
+#include "telemetry.h"
+#include "telemetry_time.h"
+#include "sliding_window.h"
+#include "frame_output.h"
+#include "sample_transport.h"
+#include "benchmark.h"
+#include "sine_lut.h"
+#include "sensor_channel.h"
+#include "latency_stats.h"
+#include "load_spike.h"
+#include "queue_stats.h"
+#include "frame_rate.h"
+#include "frame_pool.h"
+#include "frame_history.h"
+#include "rollup.h"
+#include "footprint.h"
+#include "cpu_affinity.h"
+#include "sched_edf.h"
+#if defined(CONFIG_TELEMETRY_CPU_STATS)
+#include "cpu_stats.h"
+#endif
+#if defined(CONFIG_TELEMETRY_FRAME_STORE)
+#include "frame_store.h"
+#endif
+#if defined(CONFIG_TELEMETRY_NET)
+#include "frame_net.h"
+#endif
+#if defined(CONFIG_TELEMETRY_HOST_FILE)
+#include "frame_host.h"
+#endif
+#if defined(CONFIG_TELEMETRY_REPLAY)
+#include "trace_replay.h"
+#endif
 
-struct telemetry_frame {
-    uint32_t frame_id;
-    int64_t  timestamp;
-    uint32_t uptime;
-    int      latest_sensor_value;
-    uint32_t sensor_avg_last_200ms;
-    bool     degraded;
-};
-
-struct sensor_data {
-    int64_t timestamp;
-    int sensor_value;
-};
-
-struct uptime_data {
-    int64_t timestamp;
-    uint32_t uptime;
-};
-
-/* Sensor averaging buffer */
-#define SENSOR_AVG_BUFFER_SIZE 20
-struct sensor_avg_buffer {
-    int sensor_values[SENSOR_AVG_BUFFER_SIZE];
-    int64_t timestamps[SENSOR_AVG_BUFFER_SIZE];
-    int index;
-    int count;
-};
+LOG_MODULE_REGISTER(telemetry, LOG_LEVEL_WRN);
 
 /* ========== Constants ========== */
 
-#define TELEMETRY_FRAME_RATE_MS     200  /* 5 Hz */
-#define SYNTHETIC_SENSOR_RATE_MS    50   /* 20 Hz */
-#define UPTIME_RATE_MS              1000 /* 1 Hz */
-
-#define SENSOR_QUEUE_SIZE           10
-#define UPTIME_QUEUE_SIZE           2
+#define SENSOR_AVG_WINDOW_MS        200
+#define SENSOR_DRAIN_BATCH          16   /* samples copied out of the transport per drain call */
 
-#define PRIO_AGGREGATOR             5  /* Lower number = higher priority. Aggregator has to be high priority to meet deadlines. */
-#define PRIO_PRODUCER               7
-#define PRIO_LOAD_SPIKE             10
+/* Per-source trigger bits. Also used as the trigger message ids in workqueue mode. */
+#define TRIGGER_SYNTHETIC_SENSOR    BIT(0)
+#define TRIGGER_UPTIME              BIT(1)
+#define TRIGGER_FRAME               BIT(2)  /* low-power mode: the aggregator requests the frame's batch */
+#define TRIGGER_ALL                 (TRIGGER_SYNTHETIC_SENSOR | TRIGGER_UPTIME | TRIGGER_FRAME)
 
-#define TRIGGER_SYNTHETIC_SENSOR    1
-#define TRIGGER_UPTIME              2
+#define SENSOR_TICK_US              ((int64_t)SYNTHETIC_SENSOR_RATE_MS * TELEMETRY_US_PER_MS)
+#define UPTIME_PERIOD_US            ((int64_t)UPTIME_RATE_MS * TELEMETRY_US_PER_MS)
 
 /* ========== Global Variables ========== */
 
-/* Message queues for inter-thread communication */
-K_MSGQ_DEFINE(sensor_msgq, sizeof(struct sensor_data), SENSOR_QUEUE_SIZE, 4);
-K_MSGQ_DEFINE(uptime_msgq, sizeof(struct uptime_data), UPTIME_QUEUE_SIZE, 4);
+/* Sensor and uptime transports are defined in sample_transport.c */
+#if defined(CONFIG_TELEMETRY_TRIGGER_EVENT)
+K_EVENT_DEFINE(producer_events); /* Trigger bits posted directly by the timer callbacks */
+#else
 K_MSGQ_DEFINE(trigger_msgq, sizeof(uint8_t), SENSOR_QUEUE_SIZE + UPTIME_QUEUE_SIZE, 4); /* Queue for timer-triggered work submissions */
+TELEMETRY_FOOTPRINT_DEFINE(trigger_msgq, "trigger msgq", SENSOR_QUEUE_SIZE + UPTIME_QUEUE_SIZE);
+#endif
 
 
 /* Timers for periodic operations */
 K_TIMER_DEFINE(uptime_timer, NULL, NULL);
 K_TIMER_DEFINE(synthetic_sensor_timer, NULL, NULL);
 
+#if defined(CONFIG_TELEMETRY_TRIGGER_WORKQUEUE)
 /* Work items for deferred processing */
 K_WORK_DEFINE(uptime_work, NULL);
 K_WORK_DEFINE(synthetic_sensor_work, NULL);
+#endif
 
 /* Thread stacks */
 K_THREAD_STACK_DEFINE(telemetry_aggregator_stack, 2048);
 K_THREAD_STACK_DEFINE(producer_stack, 1024);
-K_THREAD_STACK_DEFINE(load_spike_generator_stack, 1024);
 
 /* Thread control blocks */
 struct k_thread telemetry_aggregator_thread;
 struct k_thread producer_thread;
-struct k_thread load_spike_generator_thread;
 
 /* System state */
 static uint32_t frame_counter = 0;
+static struct telemetry_frame scratch_frame;  /* aggregator only, used when the frame pool is exhausted */
 static int64_t system_start_time = 0;
+static bool replay_active;  /* a trace replay thread feeds the sensor transport instead of the sensor timer */
+
+/* Telemetry time stamps taken by the timer ISRs of the latest sensor and uptime ticks */
+static struct k_spinlock tick_stamp_lock;
+static int64_t sensor_tick_us;
+static int64_t uptime_tick_us;
+
+/* Timer wakeups of the data path, counted once per tick so timers expiring together count once */
+static atomic_t wakeup_count;
+static atomic_t wakeup_tick;
+
+#if defined(CONFIG_TELEMETRY_LOW_POWER)
+K_SEM_DEFINE(frame_batch_done, 0, 1);   /* producer -> aggregator, the frame's batch is queued */
+
+/* Producer only */
+static bool batch_sensor;               /* sensor ticks are batched, the sensor timer stays off */
+static int64_t batch_next_tick_us;      /* nominal time of the next sensor tick */
+static int64_t batch_next_uptime_us;
+#endif
+
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+/* Cycle stamps of the latest sensor tick: timer ISR, and the hop that woke the producer */
+static atomic_t sensor_isr_cycles;
+static atomic_t sensor_wake_cycles;
+#endif
+
+/* Producer per-channel sampling schedule, struct-of-arrays indexed by channel */
+static uint16_t producer_divider[CONFIG_TELEMETRY_MAX_CHANNELS];    /* channel period in sensor ticks */
+static uint16_t producer_countdown[CONFIG_TELEMETRY_MAX_CHANNELS];  /* sensor ticks until the next sample */
+static uint32_t producer_seq[CONFIG_TELEMETRY_MAX_CHANNELS];
+
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+#define SENSOR_SUMMARY_WATERMARK    (SENSOR_TRANSPORT_CAPACITY * CONFIG_TELEMETRY_SENSOR_SUMMARY_WATERMARK / 100)
+
+/* Producer only: samples folded per channel while the transport is above the watermark, count 0 when empty */
+static struct sensor_data producer_summary[CONFIG_TELEMETRY_MAX_CHANNELS];
+static uint16_t producer_summary_max[CONFIG_TELEMETRY_MAX_CHANNELS];   /* samples that span at most the window */
+static atomic_t summarized_samples;     /* samples that travelled inside a summary record */
+#endif
+
+/* Aggregator per-channel state, struct-of-arrays indexed by channel */
+static struct sliding_window channel_window[CONFIG_TELEMETRY_MAX_CHANNELS] __aligned(TELEMETRY_CACHE_LINE);
+static int64_t channel_latest_timestamp[CONFIG_TELEMETRY_MAX_CHANNELS];
+static int32_t channel_latest_value[CONFIG_TELEMETRY_MAX_CHANNELS];
+static int64_t channel_fresh_us[CONFIG_TELEMETRY_MAX_CHANNELS];
+static bool    channel_seen[CONFIG_TELEMETRY_MAX_CHANNELS];
+TELEMETRY_FOOTPRINT_DEFINE(aggregator_state, "aggregator channels",
+                           sizeof(channel_window) + sizeof(channel_latest_timestamp) + sizeof(channel_latest_value) +
+                           sizeof(channel_fresh_us) + sizeof(channel_seen) + sizeof(scratch_frame));
+
+#if defined(CONFIG_TELEMETRY_ROLLUP)
+static struct rollup primary_rollup;  /* aggregator only */
+#endif
 
 /* ========== Utility Functions ========== */
 
+/* Same base as the sample and frame stamps; a cycle counter need not start at kernel boot like k_uptime_get() */
 static inline int64_t get_current_timestamp_ms(void)
 {
-    return k_uptime_get();
+    return telemetry_time_us() / TELEMETRY_US_PER_MS;
 }
 
-static bool is_data_fresh(int64_t data_timestamp, int64_t current_time, int64_t timeout_ms)
+/* All three in telemetry time (us) */
+static bool is_data_fresh(int64_t data_timestamp, int64_t current_time, int64_t timeout_us)
 {
-    return (current_time - data_timestamp) <= timeout_ms;
+    return (current_time - data_timestamp) <= timeout_us;
 }
 
-static void add_sensor_to_avg_buffer(struct sensor_avg_buffer *buffer, struct sensor_data data)
+/* 64-bit stamps written by an ISR are read under the lock, a 32-bit CPU cannot load them at once */
+static inline void set_tick_stamp(int64_t *stamp)
 {
-    buffer->sensor_values[buffer->index] = data.sensor_value;
-    buffer->timestamps[buffer->index] = data.timestamp;
-    
-    buffer->index = (buffer->index + 1) % SENSOR_AVG_BUFFER_SIZE;
-    if (buffer->count < SENSOR_AVG_BUFFER_SIZE) {
-        buffer->count++;
+    int64_t now = telemetry_time_us();
+    k_spinlock_key_t key = k_spin_lock(&tick_stamp_lock);
+
+    *stamp = now;
+    k_spin_unlock(&tick_stamp_lock, key);
+}
+
+static inline int64_t get_tick_stamp(const int64_t *stamp)
+{
+    k_spinlock_key_t key = k_spin_lock(&tick_stamp_lock);
+    int64_t value = *stamp;
+
+    k_spin_unlock(&tick_stamp_lock, key);
+    return value;
+}
+
+/* Timer expiry context. The first expiry of a tick counts, the others share its wakeup. */
+static inline void note_wakeup(void)
+{
+    atomic_val_t tick = (atomic_val_t)k_uptime_ticks();
+    atomic_val_t last = atomic_get(&wakeup_tick);
+
+    if (tick != last && atomic_cas(&wakeup_tick, last, tick)) {
+        atomic_inc(&wakeup_count);
     }
 }
 
-static uint32_t calculate_sensor_avg_200ms(struct sensor_avg_buffer *buffer)
+/* Updates avg/min/max and, with CONFIG_TELEMETRY_WINDOW_STATS, the variance and histogram in O(1) */
+static void add_sensor_to_avg_buffer(struct sliding_window *window, const struct sensor_data *data,
+                                     int64_t timestamp_us)
 {
-    int64_t cutoff_time = get_current_timestamp_ms() - 200;
-    int sum = 0;
-    int count = 0;
-    
-    for (int i = 0; i < buffer->count; i++) {
-        if (buffer->timestamps[i] >= cutoff_time) {
-            sum += buffer->sensor_values[i];
-            count++;
-        }
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+    sliding_window_add_summary(window, data->min, data->max, data->sum, data->count, timestamp_us);
+#else
+    sliding_window_add(window, data->sensor_value, timestamp_us);
+#endif
+}
+
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+/*
+ * Folds msg into the channel's summary while the transport is above the watermark. Returns the record
+ * to queue now: msg itself, the summary once the transport drained or the summary is full, or NULL.
+ */
+static struct sensor_data *summarize_sample(struct sensor_data *msg)
+{
+    struct sensor_data *acc = &producer_summary[msg->channel];
+    bool backlogged = sensor_transport_used() >= SENSOR_SUMMARY_WATERMARK;
+
+    msg->count = 1;
+    msg->min = msg->sensor_value;
+    msg->max = msg->sensor_value;
+    msg->sum = msg->sensor_value;
+
+    if (acc->count == 0 && !backlogged) {
+        return msg;
     }
-    
-    return count > 0 ? (uint32_t)(sum / count) : 0;
+
+    if (acc->count == 0) {
+        *acc = *msg;
+    } else {
+        int32_t min = MIN(acc->min, msg->sensor_value);
+        int32_t max = MAX(acc->max, msg->sensor_value);
+        int32_t sum = acc->sum + msg->sensor_value;
+        uint16_t count = acc->count + 1;
+
+        /* The newest sample supplies the value, the timestamp and the latency stamps */
+        *acc = *msg;
+        acc->min = min;
+        acc->max = max;
+        acc->sum = sum;
+        acc->count = count;
+    }
+
+    if (backlogged && acc->count < producer_summary_max[msg->channel]) {
+        return NULL;
+    }
+    return acc;
 }
+#endif
 
 /* ========== Work Handler Functions ========== */
 
+#if defined(CONFIG_TELEMETRY_TRIGGER_WORKQUEUE)
+
 static void synthetic_sensor_work_handler(struct k_work *work)
 {
     uint8_t trigger_id = TRIGGER_SYNTHETIC_SENSOR;
 
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+    uint32_t now = k_cycle_get_32();
+
+    latency_record(LATENCY_ISR_TO_WORK, now - (uint32_t)atomic_get(&sensor_isr_cycles));
+    atomic_set(&sensor_wake_cycles, (atomic_val_t)now);
+#endif
+
     if (k_msgq_put(&trigger_msgq, &trigger_id, K_NO_WAIT) != 0) {
-        LOG_WRN("Sensor Trigger queue full, dropping data");
+        queue_stats_drop(TELEMETRY_QUEUE_TRIGGER);
     }
+    queue_stats_depth(TELEMETRY_QUEUE_TRIGGER, k_msgq_num_used_get(&trigger_msgq));
 }
 
 static void uptime_work_handler(struct k_work *work)
@@ -139,57 +268,193 @@ static void uptime_work_handler(struct k_work *work)
     uint8_t trigger_id = TRIGGER_UPTIME;
 
     if (k_msgq_put(&trigger_msgq, &trigger_id, K_NO_WAIT) != 0) {
-        LOG_WRN("Uptime Trigger queue full, dropping data");
+        queue_stats_drop(TELEMETRY_QUEUE_TRIGGER);
     }
+    queue_stats_depth(TELEMETRY_QUEUE_TRIGGER, k_msgq_num_used_get(&trigger_msgq));
 }
 
+#endif /* CONFIG_TELEMETRY_TRIGGER_WORKQUEUE */
+
 /*
  * Generates synthetic sensor data in a sine wave pattern with added random noise to simulate real-world sensor behavior.
- * The data is timestamped and put into the sensor message queue for the aggregator thread to process.
+ * This is the read function of the synthetic channels: seq is the sample index of the channel and the channel's
+ * user_data is its phase offset in sine steps.
  */
-static void synthetic_sensor_data(struct sensor_data *data)
+static int synthetic_sensor_data(const struct telemetry_channel *channel, uint32_t seq)
 {
-    if(data == NULL) {
-        return;
-    }
+    int sensor_value;
 
-    data->timestamp = get_current_timestamp_ms();
-    
     /* Generate synthetic sensor data (sine wave with noise) */
-    static uint32_t counter = 0;
+    uint32_t counter = seq + (uint32_t)channel->user_data;
+#if defined(CONFIG_TELEMETRY_SENSOR_SINE_LUT)
+    int base_value = sine_lut_scaled(counter % SINE_LUT_STEPS, 50) + 50;  /* Same waveform from the Q15 table, no floating point */
+#else
     double angle = (counter * 2.0 * 3.14159) / 100.0;  /* Complete cycle every 5 seconds at 20Hz */
     int base_value = (int)(50.0 * sin(angle)) + 50;    /* 0-100 range */
+#endif
     int noise = (sys_rand32_get() % 21) - 10;          /* ±10 noise */
-    data->sensor_value = base_value + noise;
+    sensor_value = base_value + noise;
     
-    if (data->sensor_value < 0) {
-        data->sensor_value = 0;
+    if (sensor_value < 0) {
+        sensor_value = 0;
     }
 
-    if (data->sensor_value > 100) {
-        data->sensor_value = 100;
+    if (sensor_value > 100) {
+        sensor_value = 100;
     }
     
-    counter++;
+    return sensor_value;
 }
 
+/* ========== Channel Registry ========== */
+
+/* Primary synthetic sensor, 20 Hz with a 200ms window */
+TELEMETRY_PRIMARY_CHANNEL_DEFINE(sensor, SYNTHETIC_SENSOR_RATE_MS, SENSOR_AVG_WINDOW_MS,
+                                 SYNTHETIC_SENSOR_RATE_MS + 10, synthetic_sensor_data, 0, TELEMETRY_CHANNEL_BATCH);
+
+/* Optional demo channels, phase shifted and sampled every 1 to 4 sensor ticks */
+#define DEMO_CHANNEL_RATE_MS(i)     (SYNTHETIC_SENSOR_RATE_MS * (1 + ((i) % 4)))
+#define DEMO_CHANNEL_DEFINE(i, _)                                                       \
+    TELEMETRY_CHANNEL_DEFINE(_CONCAT(demo_, i), DEMO_CHANNEL_RATE_MS(i),                \
+                             SENSOR_AVG_WINDOW_MS, DEMO_CHANNEL_RATE_MS(i) + 10,        \
+                             synthetic_sensor_data, 7 * ((i) + 1), TELEMETRY_CHANNEL_BATCH)
+
+LISTIFY(CONFIG_TELEMETRY_EXTRA_CHANNELS, DEMO_CHANNEL_DEFINE, (;), _);
+
+BUILD_ASSERT(1 + CONFIG_TELEMETRY_EXTRA_CHANNELS <= CONFIG_TELEMETRY_MAX_CHANNELS,
+             "CONFIG_TELEMETRY_MAX_CHANNELS too small for the demo channels");
+
+/*
+ * The aggregator drains the transports once per frame, so they must hold every sample of the longest
+ * frame period. A channel sampled every rate_ms puts at most one more sample than the period holds.
+ */
+#define SAMPLES_PER_FRAME_MAX(_rate_ms)     (CONFIG_TELEMETRY_FRAME_RATE_MAX_MS / (_rate_ms) + 1)
+#define DEMO_SAMPLES_PER_FRAME_MAX(i, _)    + SAMPLES_PER_FRAME_MAX(DEMO_CHANNEL_RATE_MS(i))
+#define SENSOR_SAMPLES_PER_FRAME_MAX        (SAMPLES_PER_FRAME_MAX(SYNTHETIC_SENSOR_RATE_MS) \
+                                             LISTIFY(CONFIG_TELEMETRY_EXTRA_CHANNELS, DEMO_SAMPLES_PER_FRAME_MAX, ()))
+
+BUILD_ASSERT(SENSOR_SAMPLES_PER_FRAME_MAX <= SENSOR_TRANSPORT_CAPACITY,
+             "sensor transport cannot hold one CONFIG_TELEMETRY_FRAME_RATE_MAX_MS period of samples");
+BUILD_ASSERT(SAMPLES_PER_FRAME_MAX(UPTIME_RATE_MS) <= UPTIME_TRANSPORT_CAPACITY,
+             "uptime transport cannot hold one CONFIG_TELEMETRY_FRAME_RATE_MAX_MS period of samples");
+
 /* ========== Timer Callbacks ========== */
 
 static void uptime_timer_callback(struct k_timer *timer)
 {
+    note_wakeup();
+    edf_release(EDF_UPTIME, UPTIME_RATE_MS);
+    set_tick_stamp(&uptime_tick_us);
+
+#if defined(CONFIG_TELEMETRY_TRIGGER_EVENT)
+    k_event_post(&producer_events, TRIGGER_UPTIME);
+#else
     k_work_submit(&uptime_work);
+#endif
 }
 
 static void synthetic_sensor_timer_callback(struct k_timer *timer)
 {
+    note_wakeup();
+    edf_release(EDF_SENSOR, SYNTHETIC_SENSOR_RATE_MS);
+    set_tick_stamp(&sensor_tick_us);
+
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+    uint32_t now = k_cycle_get_32();
+
+    atomic_set(&sensor_isr_cycles, (atomic_val_t)now);
+    if (IS_ENABLED(CONFIG_TELEMETRY_TRIGGER_EVENT)) {
+        atomic_set(&sensor_wake_cycles, (atomic_val_t)now);  /* no work handler hop */
+    }
+#endif
+
+#if defined(CONFIG_TELEMETRY_TRIGGER_EVENT)
+    k_event_post(&producer_events, TRIGGER_SYNTHETIC_SENSOR);
+#else
     k_work_submit(&synthetic_sensor_work);
+#endif
+}
+
+/*
+ * Blocks the producer until at least one source is due and returns the pending TRIGGER_* bits.
+ * In event mode all sources that expired since the last wakeup are returned together.
+ */
+static uint32_t wait_for_triggers(void)
+{
+#if defined(CONFIG_TELEMETRY_TRIGGER_EVENT)
+    k_event_wait(&producer_events, TRIGGER_ALL, false, K_FOREVER);
+
+    /* Read and clear in one step, so a tick posted right after the wait is kept for the next wakeup */
+    return k_event_clear(&producer_events, TRIGGER_ALL) & TRIGGER_ALL;
+#else
+    uint8_t trigger_id;
+
+    k_msgq_get(&trigger_msgq, &trigger_id, K_FOREVER);
+
+    return trigger_id;
+#endif
+}
+
+/* The aggregator's frame timer; the aggregator itself waits with k_timer_status_sync() */
+static void frame_timer_callback(struct k_timer *timer)
+{
+    ARG_UNUSED(timer);
+
+    note_wakeup();
+    edf_release(EDF_FRAME, frame_rate_period_ms());
+}
+
+#if defined(CONFIG_TELEMETRY_LOW_POWER)
+/*
+ * Has the producer queue the frame's batch and waits for it, so the samples land in this frame and
+ * the frame wakeup is the only one. A batch later than a quarter period is used by the next frame.
+ */
+static void request_frame_batch(uint32_t wake_cycles, uint32_t frame_period_ms)
+{
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+    /* The frame timer stands in for the sensor timer ISR */
+    atomic_set(&sensor_isr_cycles, (atomic_val_t)wake_cycles);
+    atomic_set(&sensor_wake_cycles, (atomic_val_t)wake_cycles);
+#else
+    ARG_UNUSED(wake_cycles);
+#endif
+
+    k_sem_reset(&frame_batch_done);
+    edf_release(EDF_UPTIME, MAX(frame_period_ms / 4, 1U));
+    k_event_post(&producer_events, TRIGGER_FRAME);
+    (void)k_sem_take(&frame_batch_done, K_MSEC(MAX(frame_period_ms / 4, 1U)));
 }
+#endif
+
+#if defined(CONFIG_TELEMETRY_CATCHUP_GAP)
+/*
+ * Reports slot_count frame slots, starting at first_id, that expired while the aggregator was preempted.
+ * One compact placeholder covers the whole run so frame_id stays aligned to time slots.
+ */
+static void submit_gap_frame(uint32_t first_id, uint32_t slot_count, int64_t timestamp)
+{
+    struct telemetry_frame *gap = frame_pool_alloc();
+
+    if (gap == NULL) {
+        return;
+    }
+
+    gap->frame_id = first_id;
+    gap->timestamp = timestamp;
+    gap->gap = true;
+    gap->slot_count = (uint16_t)MIN(slot_count, UINT16_MAX);
+    gap->degraded = true;
+
+    frame_history_record(gap);
+    frame_pool_publish(gap);
+}
+#endif
 
 /*
  * The telemetry aggregator thread is responsible for collecting data from the producer thread, 
- * generating telemetry frames at a fixed rate, and outputting them.
+ * generating telemetry frames at a fixed rate, and handing them to the deferred output stage.
  *
- * It uses a timer to ensure strict periodic wakeups every 200ms to maintain the telemetry frame rate. 
+ * It uses a timer to ensure strict periodic wakeups every 200ms (by default, see frame_rate.h) to maintain the telemetry frame rate. 
  * The thread also checks for data freshness and logs any missed deadlines or degraded conditions in the generated frames.
  */
 static void telemetry_aggregator_thread_func(void *arg1, void *arg2, void *arg3)
@@ -199,93 +464,344 @@ static void telemetry_aggregator_thread_func(void *arg1, void *arg2, void *arg3)
     ARG_UNUSED(arg3);
     
     bool frame_deadline_met;
-    int64_t current_frame_time;
+    uint32_t frame_period_ms = frame_rate_period_ms();
+    uint32_t wake_cycles;
+    uint32_t busy_start_cycles;     /* wake_cycles, or the end of the low-power batch wait */
+    uint32_t missed_slots;
+    int64_t current_frame_time;     /* telemetry time (us), like every sample stamp */
     int64_t last_frame_time;
-    bool sensor_valid;
+    int64_t frame_time;
     bool degraded;
 
-    struct uptime_data uptime_msg;
-    struct sensor_data sensor_msg;
+    struct uptime_data uptime_msg = {0};
+    int64_t uptime_time = 0;
+    int64_t drain_time;
+    struct uptime_data uptime_batch[UPTIME_TRANSPORT_CAPACITY];
+    struct sensor_data sensor_batch[SENSOR_DRAIN_BATCH];
+    uint32_t uptime_count;
+    uint32_t sensor_count;
+    uint32_t channel_count = telemetry_channel_count();
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+    uint32_t dequeue_cycles = 0;
+    uint32_t primary_isr_cycles = 0;
+#endif
+
+    for (uint32_t ch = 0; ch < channel_count; ch++) {
+        const struct telemetry_channel *channel = telemetry_channel_get(ch);
 
-    struct sensor_avg_buffer avg_buffer = {0};
+        sliding_window_init(&channel_window[ch], (int64_t)channel->window_ms * TELEMETRY_US_PER_MS);
+        channel_fresh_us[ch] = (int64_t)channel->fresh_ms * TELEMETRY_US_PER_MS;
+    }
+#if defined(CONFIG_TELEMETRY_ROLLUP)
+    rollup_init(&primary_rollup);
+#endif
 
     struct k_timer telemetry_timer;
-    k_timer_init(&telemetry_timer, NULL, NULL);
-    k_timer_start(&telemetry_timer, K_MSEC(TELEMETRY_FRAME_RATE_MS), K_MSEC(TELEMETRY_FRAME_RATE_MS));
+    k_timer_init(&telemetry_timer, frame_timer_callback, NULL);
+    k_timer_start(&telemetry_timer, K_MSEC(frame_period_ms), K_MSEC(frame_period_ms));
 
     LOG_INF("Aggregator thread started");
     
-    last_frame_time = get_current_timestamp_ms();
+    last_frame_time = telemetry_time_us();
     
     while (1) {
         /* Wait for telemetry timer */
-        k_timer_status_sync(&telemetry_timer);  // strict periodic wake
+        /* strict periodic wake; more than one expiry means frame slots passed while we were preempted */
+        missed_slots = k_timer_status_sync(&telemetry_timer);
+        missed_slots = missed_slots > 1 ? missed_slots - 1 : 0;
+        wake_cycles = k_cycle_get_32();
+        busy_start_cycles = wake_cycles;
 
         frame_deadline_met = true;
-        current_frame_time = get_current_timestamp_ms();
+        current_frame_time = telemetry_time_us();
         /* Detect and log missed deadlines (if any) */
-        if (current_frame_time - last_frame_time > TELEMETRY_FRAME_RATE_MS + 10) {
+        if (missed_slots > 0) {
             frame_deadline_met = false;
-            LOG_WRN("Frame deadline missed by %lld ms", 
-                    current_frame_time - last_frame_time - TELEMETRY_FRAME_RATE_MS);
+            LOG_WRN("Frame deadline missed, %u frame slot(s) skipped", missed_slots);
+        } else if (current_frame_time - last_frame_time > (int64_t)(frame_period_ms + 10) * TELEMETRY_US_PER_MS) {
+            frame_deadline_met = false;
+            LOG_WRN("Frame deadline missed by %lld us", 
+                    current_frame_time - last_frame_time - (int64_t)frame_period_ms * TELEMETRY_US_PER_MS);
+        }
+
+#if defined(CONFIG_TELEMETRY_CATCHUP_GAP)
+        if (missed_slots > 0) {
+            submit_gap_frame(frame_counter + 1, missed_slots, last_frame_time / TELEMETRY_US_PER_MS + frame_period_ms);
+        }
+        frame_counter += missed_slots;
+#elif defined(CONFIG_TELEMETRY_CATCHUP_MERGE)
+        /* Widen every window over the skipped slots; the samples are still queued in the transport */
+        for (uint32_t ch = 0; ch < channel_count; ch++) {
+            sliding_window_set_span(&channel_window[ch],
+                                    (int64_t)telemetry_channel_get(ch)->window_ms * TELEMETRY_US_PER_MS *
+                                    (1 + missed_slots));
         }
+        frame_counter += missed_slots;
+#endif
+#if defined(CONFIG_TELEMETRY_BENCHMARK)
+        benchmark_frame_hook(wake_cycles, frame_deadline_met);
+#endif
+#if defined(CONFIG_TELEMETRY_LOW_POWER)
+        request_frame_batch(wake_cycles, frame_period_ms);
+        /* The batch wait is idle time, it must not count as load for the CPU stats or the frame rate */
+        busy_start_cycles = k_cycle_get_32();
+#endif
         
-        /* Process all available data */
-        while (k_msgq_get(&uptime_msgq, &uptime_msg, K_NO_WAIT) == 0) {
-            /* keep draining the queue to get the latest uptime message */
+        /* Process all available data; stamps are widened right away, while they are young */
+        drain_time = telemetry_time_us();
+        uptime_count = uptime_transport_drain(uptime_batch, UPTIME_TRANSPORT_CAPACITY);
+        if (uptime_count > 0) {
+            /* only the latest uptime message is of interest */
+            uptime_msg = uptime_batch[uptime_count - 1];
+            uptime_time = sample_time_unpack(uptime_msg.timestamp_us, drain_time);
         }
         
-        sensor_valid = false;
-        while (k_msgq_get(&sensor_msgq, &sensor_msg, K_NO_WAIT) == 0) {
-            sensor_valid = true;
-            add_sensor_to_avg_buffer(&avg_buffer, sensor_msg);
+        /* Samples of all channels share one transport; bounded to one transport's worth per frame */
+        for (uint32_t drained = 0; drained < SENSOR_TRANSPORT_CAPACITY; drained += sensor_count) {
+            sensor_count = sensor_transport_drain(sensor_batch, SENSOR_DRAIN_BATCH);
+            if (sensor_count == 0) {
+                break;
+            }
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+            dequeue_cycles = k_cycle_get_32();
+#endif
+
+            for (uint32_t i = 0; i < sensor_count; i++) {
+                uint16_t ch = sensor_batch[i].channel;
+                int64_t sample_time = sample_time_unpack(sensor_batch[i].timestamp_us, drain_time);
+
+                add_sensor_to_avg_buffer(&channel_window[ch], &sensor_batch[i], sample_time);
+                channel_latest_value[ch] = sensor_batch[i].sensor_value;
+                channel_latest_timestamp[ch] = sample_time;
+                channel_seen[ch] = true;
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+                latency_record(LATENCY_ENQUEUE_TO_DEQUEUE, dequeue_cycles - sensor_batch[i].enqueue_cycles);
+                if (ch == 0) {
+                    primary_isr_cycles = sensor_batch[i].isr_cycles;
+                }
+#endif
+            }
         }
         
-        /* Generate telemetry frame */
-        struct telemetry_frame frame = {0};
-        frame.frame_id = ++frame_counter;
-        frame.timestamp = get_current_timestamp_ms();
+        /* Generate telemetry frame in place in a pool block; with the pool exhausted it is built in scratch and dropped */
+        struct telemetry_frame *frame = frame_pool_alloc();
+
+        if (frame == NULL) {
+            frame = &scratch_frame;
+            *frame = (struct telemetry_frame){0};
+        }
+        frame->frame_id = ++frame_counter;
+        frame_time = telemetry_time_us();
+        frame->timestamp = frame_time / TELEMETRY_US_PER_MS;
+        frame->slot_count = IS_ENABLED(CONFIG_TELEMETRY_CATCHUP_MERGE) ? 1 + missed_slots : 1;
         
         degraded = false;
         
         /* Check uptime data freshness */
-        if (is_data_fresh(uptime_msg.timestamp, frame.timestamp, 2*UPTIME_RATE_MS + 10)) {
-            frame.uptime = uptime_msg.uptime;
+        if (is_data_fresh(uptime_time, frame_time, (2*UPTIME_RATE_MS + 10) * TELEMETRY_US_PER_MS)) {
+            frame->uptime = uptime_msg.uptime;
         } else {
-            frame.uptime = (uint32_t)((frame.timestamp - system_start_time) / 1000);
+            frame->uptime = (uint32_t)((frame->timestamp - system_start_time) / 1000);
             degraded = true;
         }
 
-        /* Check sensor data freshness */
-        if (sensor_valid && 
-            is_data_fresh(sensor_msg.timestamp, frame.timestamp, SYNTHETIC_SENSOR_RATE_MS + 10)) {
-            frame.latest_sensor_value = sensor_msg.sensor_value;
-        } else {
-            frame.latest_sensor_value = -1;  /* Invalid marker */
-            degraded = true;
+        /* Check freshness and collect the window statistics of every channel */
+        frame->channel_count = (uint8_t)channel_count;
+        for (uint32_t ch = 0; ch < channel_count; ch++) {
+            struct telemetry_channel_stats *stats = &frame->channels[ch];
+            struct sliding_window *window = &channel_window[ch];
+
+            if (channel_seen[ch] &&
+                is_data_fresh(channel_latest_timestamp[ch], frame_time, channel_fresh_us[ch])) {
+                stats->latest = channel_latest_value[ch];
+            } else {
+                stats->latest = -1;  /* Invalid marker */
+                degraded = true;
+            }
+
+            /* Window is maintained incrementally; only samples that aged out since the last frame are evicted here */
+            sliding_window_expire(window, frame_time);
+            if (sliding_window_count(window) > 0) {
+                stats->avg = sliding_window_avg(window);
+                stats->min = sliding_window_min(window);
+                stats->max = sliding_window_max(window);
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+                stats->stddev = sliding_window_stddev(window);
+                stats->p50 = sliding_window_quantile(window, 50);
+                stats->p95 = sliding_window_quantile(window, 95);
+#endif
+            } else {
+                stats->avg = -1;
+                stats->min = -1;
+                stats->max = -1;
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+                stats->stddev = -1;
+                stats->p50 = -1;
+                stats->p95 = -1;
+#endif
+            }
+        }
+
+        /* The primary channel fills the single-sensor fields */
+        frame->latest_sensor_value = frame->channels[0].latest;
+        frame->sensor_avg_last_200ms = frame->channels[0].avg < 0 ? 0 : (uint32_t)frame->channels[0].avg;
+        frame->sensor_min_last_200ms = frame->channels[0].min;
+        frame->sensor_max_last_200ms = frame->channels[0].max;
+#if defined(CONFIG_TELEMETRY_ROLLUP)
+        /* O(1) per frame; coarser buckets travel with the frame on which they close */
+        frame->rollup_closed = rollup_add(&primary_rollup, frame->timestamp, &frame->channels[0],
+                                          frame->slot_count, frame->rollups);
+#endif
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+        frame->sample_isr_cycles = primary_isr_cycles;
+        frame->assembled_cycles = k_cycle_get_32();
+#endif
+        frame->degraded = degraded || !frame_deadline_met;
+
+        last_frame_time = frame_time;
+        frame_history_record(frame);
+
+        /* Fan the frame out to every sink; formatting, console, flash and network I/O happen off the deadline path */
+        if (frame != &scratch_frame) {
+            frame_pool_publish(frame);
+        }
+
+#if defined(CONFIG_TELEMETRY_CATCHUP_MERGE)
+        if (missed_slots > 0) {
+            for (uint32_t ch = 0; ch < channel_count; ch++) {
+                sliding_window_set_span(&channel_window[ch],
+                                        (int64_t)telemetry_channel_get(ch)->window_ms * TELEMETRY_US_PER_MS);
+            }
+        }
+#endif
+
+        /* Apply a requested or adaptive period change; restarting the timer re-phases the frame slots */
+        uint32_t busy_us = k_cyc_to_us_floor32(k_cycle_get_32() - busy_start_cycles);
+
+#if defined(CONFIG_TELEMETRY_CPU_STATS)
+        cpu_stats_frame(busy_us);
+#endif
+        edf_done(EDF_FRAME);
+        if (frame_rate_update(busy_us, frame_deadline_met)) {
+            frame_period_ms = frame_rate_period_ms();
+            k_timer_start(&telemetry_timer, K_MSEC(frame_period_ms), K_MSEC(frame_period_ms));
         }
-        
-        frame.sensor_avg_last_200ms = calculate_sensor_avg_200ms(&avg_buffer);
-        frame.degraded = degraded || !frame_deadline_met;
-
-        /* Output frame */
-        printk("FRAME %u | ts=%lld | up=%u | sensor=%d | avg=%u | degraded=%d\n",
-               frame.frame_id, frame.timestamp, frame.uptime,
-               frame.latest_sensor_value, frame.sensor_avg_last_200ms,
-               frame.degraded ? 1 : 0);
-        
-        last_frame_time = frame.timestamp;
     }
     
     LOG_INF("Aggregator thread stopped");
 }
 
+/*
+ * Samples every channel that is due on one sensor tick, in one loop over the channel table.
+ * stamp_us is the tick's timer ISR stamp, or its nominal time when the tick is sampled in a batch.
+ */
+static void produce_sensor_tick(const struct telemetry_channel *channels, uint32_t channel_count, int64_t stamp_us)
+{
+    struct sensor_data sensor_msg;
+
+    sensor_msg.timestamp_us = sample_time_pack(stamp_us);
+    for (uint32_t ch = 0; ch < channel_count; ch++) {
+        if (--producer_countdown[ch] != 0) {
+            continue;
+        }
+        producer_countdown[ch] = producer_divider[ch];
+
+        sensor_msg.channel = (uint16_t)ch;
+        sensor_msg.sensor_value = channels[ch].read(&channels[ch], producer_seq[ch]++);
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+        sensor_msg.isr_cycles = (uint32_t)atomic_get(&sensor_isr_cycles);
+        sensor_msg.enqueue_cycles = k_cycle_get_32();
+        latency_record(LATENCY_TO_ENQUEUE,
+                       sensor_msg.enqueue_cycles - (uint32_t)atomic_get(&sensor_wake_cycles));
+#endif
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+        struct sensor_data *record = summarize_sample(&sensor_msg);
+
+        if (record == NULL) {
+            continue;  /* folded, the summary goes out once the transport drains */
+        }
+        uint16_t samples = record->count;
+
+        /* A dropped summary counts every sample in it; the transport copied it either way */
+        if (!sensor_transport_put(record)) {
+            queue_stats_drop_many(TELEMETRY_QUEUE_SENSOR, samples);
+        } else if (samples > 1) {
+            atomic_add(&summarized_samples, samples);
+        }
+        producer_summary[ch].count = 0;
+#else
+        /* Drops are only counted here; the monitor thread reports them once per STATUS interval */
+        if (!sensor_transport_put(&sensor_msg)) {
+            queue_stats_drop(TELEMETRY_QUEUE_SENSOR);
+        }
+#endif
+        queue_stats_depth(TELEMETRY_QUEUE_SENSOR, sensor_transport_used());
+    }
+}
+
+static void produce_uptime(int64_t stamp_us)
+{
+    struct uptime_data uptime_msg;
+
+    uptime_msg.timestamp_us = sample_time_pack(stamp_us);
+    uptime_msg.uptime = (uint32_t)((stamp_us / TELEMETRY_US_PER_MS - system_start_time) / 1000);
+    if (!uptime_transport_put(&uptime_msg)) {
+        queue_stats_drop(TELEMETRY_QUEUE_UPTIME);
+    }
+    queue_stats_depth(TELEMETRY_QUEUE_UPTIME, uptime_transport_used());
+}
+
+#if defined(CONFIG_TELEMETRY_LOW_POWER)
+/*
+ * Low-power mode batch, run once per frame on the aggregator's request. Every sensor tick that passed
+ * since the previous batch is sampled now under its nominal time, and the first frame of every uptime
+ * period carries an uptime sample. Ticks beyond one transport's worth are skipped, like timer
+ * expiries that coalesce into one event.
+ */
+static void produce_frame_batch(const struct telemetry_channel *channels, uint32_t channel_count)
+{
+    int64_t now = telemetry_time_us();
+
+    if (batch_sensor) {
+        batch_next_tick_us = MAX(batch_next_tick_us, now - (SENSOR_TRANSPORT_CAPACITY - 1) * SENSOR_TICK_US);
+        for (; batch_next_tick_us <= now; batch_next_tick_us += SENSOR_TICK_US) {
+            produce_sensor_tick(channels, channel_count, batch_next_tick_us);
+        }
+    }
+
+    if (now >= batch_next_uptime_us) {
+        produce_uptime(now);
+        while (batch_next_uptime_us <= now) {
+            batch_next_uptime_us += UPTIME_PERIOD_US;
+        }
+    }
+}
+
+/* Ticks can only be sampled late when every channel allows it, and not while a trace replaces the sensor */
+static bool sensor_batchable(const struct telemetry_channel *channels, uint32_t channel_count)
+{
+    if (replay_active) {
+        return false;
+    }
+    for (uint32_t ch = 0; ch < channel_count; ch++) {
+        if ((channels[ch].flags & TELEMETRY_CHANNEL_BATCH) == 0) {
+            LOG_WRN("Channel %s cannot be batched, sensor timer stays on", channels[ch].name);
+            return false;
+        }
+    }
+
+    return true;
+}
+#endif
+
 /*
  * Producer thread simulates data generation for uptime and synthetic sensor at their respective rates.
  * It uses timers to trigger strict periodic wakeups for data generation.
  * 
  * Uptime data is generated every 1 second, while synthetic sensor data is generated every 50ms.
  * Synthetic sensor data: sine wave with added random noise to simulate real-world sensor behavior.
+ * Each 50ms sensor tick samples every registered channel whose period has elapsed, in one loop over the channel table.
+ * In low-power mode both timers stay off where possible and the aggregator's frame wakeup triggers one batch instead.
  */
 static void producer_thread_func(void *arg1, void *arg2, void *arg3)
 {
@@ -293,95 +809,79 @@ static void producer_thread_func(void *arg1, void *arg2, void *arg3)
     ARG_UNUSED(arg2);
     ARG_UNUSED(arg3);
 
-    struct uptime_data uptime_msg;
-    struct sensor_data sensor_msg;
-    uint8_t trigger_id;
+    uint32_t triggers;
+    uint32_t channel_count = telemetry_channel_count();
+    const struct telemetry_channel *channels = telemetry_channel_get(0);
+    bool sensor_timer_on = !replay_active;
+    bool uptime_timer_on = true;
+
+    for (uint32_t ch = 0; ch < channel_count; ch++) {
+        producer_divider[ch] = (uint16_t)(channels[ch].rate_ms / SYNTHETIC_SENSOR_RATE_MS);
+        producer_countdown[ch] = 1;  /* first sample on the first tick */
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+        /* A summary is one window slot stamped with its newest sample; its oldest must not be stale yet */
+        producer_summary_max[ch] = (uint16_t)CLAMP(channels[ch].window_ms / channels[ch].rate_ms, 1U,
+                                                   (uint32_t)CONFIG_TELEMETRY_SENSOR_SUMMARY_MAX_SAMPLES);
+#endif
+    }
+
+#if defined(CONFIG_TELEMETRY_LOW_POWER)
+    int64_t now = telemetry_time_us();
+
+    batch_sensor = sensor_batchable(channels, channel_count);
+    batch_next_tick_us = now + SENSOR_TICK_US;
+    batch_next_uptime_us = now + UPTIME_PERIOD_US;
+    sensor_timer_on = sensor_timer_on && !batch_sensor;
+    uptime_timer_on = false;
+#endif
 
     LOG_INF("Producer thread started");
     
     /* Start producer timers */
-    k_timer_start(&uptime_timer, K_MSEC(UPTIME_RATE_MS), K_MSEC(UPTIME_RATE_MS));
-    k_timer_start(&synthetic_sensor_timer, K_MSEC(SYNTHETIC_SENSOR_RATE_MS), K_MSEC(SYNTHETIC_SENSOR_RATE_MS));
+    if (uptime_timer_on) {
+        k_timer_start(&uptime_timer, K_MSEC(UPTIME_RATE_MS), K_MSEC(UPTIME_RATE_MS));
+    }
+    if (sensor_timer_on) {
+        k_timer_start(&synthetic_sensor_timer, K_MSEC(SYNTHETIC_SENSOR_RATE_MS), K_MSEC(SYNTHETIC_SENSOR_RATE_MS));
+    }
     
     while (1) {
-        /* Wait for timer-triggered event */
-        k_msgq_get(&trigger_msgq, &trigger_id, K_FOREVER);
+        /* Wait for timer-triggered event(s) */
+        triggers = wait_for_triggers();
 
-        if (trigger_id == TRIGGER_SYNTHETIC_SENSOR) {
-            synthetic_sensor_data(&sensor_msg);
-            if (k_msgq_put(&sensor_msgq, &sensor_msg, K_NO_WAIT) != 0) {
-                LOG_WRN("Sensor queue full, dropping data");
-            }
-        } else if (trigger_id == TRIGGER_UPTIME) {
-            uptime_msg.timestamp = get_current_timestamp_ms();
-            uptime_msg.uptime = (uint32_t)((uptime_msg.timestamp - system_start_time) / 1000);
-            if (k_msgq_put(&uptime_msgq, &uptime_msg, K_NO_WAIT) != 0) {
-                LOG_WRN("Uptime queue full, dropping data");
-            }
+        if (triggers & TRIGGER_SYNTHETIC_SENSOR) {
+            /* One ISR timestamp per tick, every channel that is due on this tick is sampled in one pass */
+            produce_sensor_tick(channels, channel_count, get_tick_stamp(&sensor_tick_us));
+            edf_done(EDF_SENSOR);
         }
-    }
-    
-    LOG_INF("Producer thread stopped");
-}
 
-/*
- * Load spike generator thread simulates CPU load spikes at random intervals to test the aggregator's ability
- * to handle scheduling pressure and maintain frame deadlines. 
- *
- * The load pattern is designed to be realistic with intermittent bursts of busy work followed by idle periods, 
- * which can help identify potential issues in the aggregator's scheduling and data processing logic under varying load conditions.
- */
-static void load_spike_generator_thread_func(void *arg1, void *arg2, void *arg3)
-{
-    ARG_UNUSED(arg1);
-    ARG_UNUSED(arg2);
-    ARG_UNUSED(arg3);
-    
-    LOG_INF("Load simulation thread started");
-
-    uint32_t next_load_spike_interval;
-    uint32_t load_spike_burst_duration;
-    
-    while (1) {
-        // idle time before next spike (reduce cpu load)
-        next_load_spike_interval = CONFIG_NEXT_LOAD_SPIKE_MIN_INTERVAL_MS + 
-                                  (sys_rand32_get() % (CONFIG_NEXT_LOAD_SPIKE_MAX_INTERVAL_MS - CONFIG_NEXT_LOAD_SPIKE_MIN_INTERVAL_MS));
-        k_sleep(K_MSEC(next_load_spike_interval));
-
-        // Simulate scheduling pressure by introducing busy spike time (generate cpu load)
-        load_spike_burst_duration = CONFIG_LOAD_SPIKE_MIN_DURATION_MS + 
-                             (sys_rand32_get() % (CONFIG_LOAD_SPIKE_MAX_DURATION_MS - CONFIG_LOAD_SPIKE_MIN_DURATION_MS));
+        if (triggers & TRIGGER_UPTIME) {
+            produce_uptime(get_tick_stamp(&uptime_tick_us));
+            edf_done(EDF_UPTIME);
+        }
 
-        LOG_DBG("After interval of %u ms, executing load spike for %u ms", next_load_spike_interval, load_spike_burst_duration);
-        
-        /* Simulate CPU-intensive work */
-        int64_t load_spike_start = get_current_timestamp_ms();
-        volatile uint32_t dummy = 0;
-        
-        while ((get_current_timestamp_ms() - load_spike_start) < load_spike_burst_duration) {
-            /* Perform some meaningless calculations to keep the CPU busy */
-            for (int i = 0; i < 1000; i++) {
-                dummy += sys_rand32_get();
-            }
-            /* Small yield to prevent complete system lockup */
-            if ((dummy % 10000) == 0) {
-                k_yield();
-            }
+#if defined(CONFIG_TELEMETRY_LOW_POWER)
+        if (triggers & TRIGGER_FRAME) {
+            produce_frame_batch(channels, channel_count);
+            edf_done(EDF_UPTIME);
+            k_sem_give(&frame_batch_done);
         }
-        
-        LOG_DBG("Load spike completed");
+#endif
     }
     
-    LOG_INF("Load Spike Generator stopped");
+    LOG_INF("Producer thread stopped");
 }
 
 /* 
  * Initializes the work handlers for uptime and synthetic sensor. 
+ * Only used in workqueue trigger mode; in event mode the timer callbacks signal the producer directly.
  */
 static void init_workers(void)
 {
+#if defined(CONFIG_TELEMETRY_TRIGGER_WORKQUEUE)
     k_work_init(&uptime_work, uptime_work_handler);
     k_work_init(&synthetic_sensor_work, synthetic_sensor_work_handler);
+#endif
     /* No need to initialize a handler for Telemetry and Load work because:
      * Telemetry work is handled directly in the aggregator thread by using strict periodic wake
      * Load work is handled directly in the load spike thread */
@@ -389,7 +889,8 @@ static void init_workers(void)
 
 /* 
  * Initializes the timers for uptime data and synthetic sensor data. 
- * Each timer is associated with its respective callback function that submits work(just a trigger message) to the appropriate work queue.
+ * Each timer is associated with its respective callback function that submits work(just a trigger message) to the appropriate work queue,
+ * or in event mode posts the source's trigger bit straight to the producer.
  */
 static void init_timers(void)
 {
@@ -400,6 +901,25 @@ static void init_timers(void)
      * load spikes are irregular activity with intermittent burst, strict deadline is not required (not even for logging) */
 }
 
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+/* 
+ * Appends p50/p99/max of every instrumented hop to the STATUS line.
+ */
+static void print_latency_status(void)
+{
+    struct latency_summary summary;
+
+    for (int stage = 0; stage < LATENCY_STAGE_COUNT; stage++) {
+        latency_summarize(stage, &summary);
+        if (summary.count == 0) {
+            continue;
+        }
+        printk(" | %s p50/p99/max %u/%u/%u us", latency_stage_name(stage),
+               summary.p50_us, summary.p99_us, summary.max_us);
+    }
+}
+#endif
+
 /* 
  * Main function initializes the system, starts the telemetry aggregator thread, and simulates data production and load spikes. 
  * The main thread also periodically prints status updates about the number of frames generated and system uptime.
@@ -410,41 +930,130 @@ int main(void)
     
     system_start_time = get_current_timestamp_ms();
 
+#if defined(CONFIG_TELEMETRY_BENCHMARK)
+    /* Micro benchmarks run before the application threads exist */
+    benchmark_run_micro();
+#endif
+
     init_workers();
 
+#if defined(CONFIG_TELEMETRY_FRAME_STORE)
+    /* Persistent frame log; frame_id continues after the newest stored frame */
+    int64_t stored_frame_id = frame_store_init();
+
+    if (stored_frame_id > 0) {
+        frame_counter = (uint32_t)stored_frame_id;
+        printk("Frame log holds frames up to %u\n", frame_counter);
+    }
+#endif
+
+#if defined(CONFIG_TELEMETRY_NET)
+    /* UDP sink sender (priority 9), fed by the output thread */
+    if (frame_net_init() != 0) {
+        printk("UDP frame sink disabled\n");
+    }
+#endif
+
+#if defined(CONFIG_TELEMETRY_HOST_FILE)
+    /* native_sim host file sink writer (priority 9) */
+    if (frame_host_init() != 0) {
+        printk("Host frame file sink disabled\n");
+    }
+#endif
+
+    /* Deferred output thread (priority 8) that formats and reports frames handed over by the aggregator */
+    frame_output_init();
+
     /* Telemetry thread (priority 5) which aggregates data from the producer thread */
     k_thread_create(&telemetry_aggregator_thread, telemetry_aggregator_stack,
                     K_THREAD_STACK_SIZEOF(telemetry_aggregator_stack),
                     telemetry_aggregator_thread_func, NULL, NULL, NULL,
-                    PRIO_AGGREGATOR, 0, K_NO_WAIT);
+                    PRIO_AGGREGATOR, 0, K_FOREVER);
+    k_thread_name_set(&telemetry_aggregator_thread, "aggregator");
+    edf_register(&telemetry_aggregator_thread, PRIO_AGGREGATOR, BIT(EDF_FRAME));
+    cpu_affinity_register(&telemetry_aggregator_thread, CPU_ROLE_AGGREGATOR, 0);
+    k_thread_start(&telemetry_aggregator_thread);
                     
+#if defined(CONFIG_TELEMETRY_REPLAY)
+    /* A recorded trace replaces the synthetic sensor samples; without a usable trace they stay on */
+    replay_active = trace_replay_init() == 0;
+#endif
+
     /* Data production thread (priority 7) that generates uptime and synthetic sensor data at their respective rates. */
     k_thread_create(&producer_thread, producer_stack,
                     K_THREAD_STACK_SIZEOF(producer_stack),
                     producer_thread_func, NULL, NULL, NULL,
-                    PRIO_PRODUCER, 0, K_NO_WAIT);
+                    PRIO_PRODUCER, 0, K_FOREVER);
+    k_thread_name_set(&producer_thread, "producer");
+    edf_register(&producer_thread, PRIO_PRODUCER, BIT(EDF_UPTIME) | (replay_active ? 0 : BIT(EDF_SENSOR)));
+    cpu_affinity_register(&producer_thread, CPU_ROLE_PRODUCER, 0);
+    k_thread_start(&producer_thread);
 
     /* Load spike generator thread (priority 10) that simulates CPU load spikes at random intervals to test 
      * the aggregator's ability to handle scheduling pressure and maintain frame deadlines. */
-    k_thread_create(&load_spike_generator_thread, load_spike_generator_stack,
-                    K_THREAD_STACK_SIZEOF(load_spike_generator_stack),
-                    load_spike_generator_thread_func, NULL, NULL, NULL,
-                    PRIO_LOAD_SPIKE, 0, K_NO_WAIT);
+    load_spike_init();
     
     init_timers();
     
     printk("Aggregating telemetry data...\n");
+
+#if defined(CONFIG_TELEMETRY_BENCHMARK)
+    /* Deadline benchmark drives the live system through the load profiles, then monitoring continues */
+    benchmark_run_profiles();
+#endif
     
     /* Main thread becomes monitoring thread */
     int64_t last_status_time = get_current_timestamp_ms();
+    uint32_t last_wakeups = (uint32_t)atomic_get(&wakeup_count);
+#if defined(CONFIG_TELEMETRY_CPU_STATS)
+    cpu_stats_init();
+#endif
+#if defined(CONFIG_TELEMETRY_FOOTPRINT)
+    footprint_report_ram();
+#endif
     
     while (1) {
         k_sleep(K_MSEC(5000));
         
         int64_t current_time = get_current_timestamp_ms();
         if (current_time - last_status_time >= 10000) { /* Status every 10 seconds */
-            printk("--- STATUS: Total frames generated %u, system uptime %lld s ---\n",
-                   frame_counter, (current_time - system_start_time) / 1000);
+            printk("--- STATUS: Total frames generated %u, output dropped %u, system uptime %lld s",
+                   frame_counter, frame_output_dropped(), (current_time - system_start_time) / 1000);
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+            printk(", summarized %u", (uint32_t)atomic_get(&summarized_samples));
+#endif
+            /* Tenths of a wakeup per second over the interval */
+            uint32_t wakeups = (uint32_t)atomic_get(&wakeup_count);
+            uint32_t wakeup_rate = (uint32_t)((wakeups - last_wakeups) * 10000ULL / (current_time - last_status_time));
+
+            printk(", wakeups %u.%u/s", wakeup_rate / 10, wakeup_rate % 10);
+            last_wakeups = wakeups;
+#if defined(CONFIG_TELEMETRY_NET)
+            printk(", net backlog %u dropped %u", frame_net_backlog(), queue_stats_drops(TELEMETRY_QUEUE_NET));
+#endif
+#if defined(CONFIG_TELEMETRY_HOST_FILE)
+            printk(", file backlog %u dropped %u", frame_host_backlog(), queue_stats_drops(TELEMETRY_QUEUE_HOST));
+#endif
+#if defined(CONFIG_TELEMETRY_REPLAY)
+            if (replay_active) {
+                trace_replay_report();
+            }
+#endif
+            queue_stats_report();
+#if defined(CONFIG_TELEMETRY_EDF)
+            edf_report();
+#endif
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+            print_latency_status();
+#endif
+            printk(" ---\n");
+#if defined(CONFIG_TELEMETRY_CPU_STATS)
+            cpu_stats_report();
+#endif
+#if defined(CONFIG_TELEMETRY_FOOTPRINT)
+            footprint_report_stacks();
+#endif
+            queue_stats_warn();
             last_status_time = current_time;
         }
     }
@@ -0,0 +1,53 @@
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/logging/log.h>
+
+#include "queue_stats.h"
+
+LOG_MODULE_DECLARE(telemetry);
+
+atomic_t queue_drop_count[TELEMETRY_QUEUE_COUNT];
+atomic_t queue_depth[TELEMETRY_QUEUE_COUNT];
+atomic_t queue_high_water[TELEMETRY_QUEUE_COUNT];
+
+static uint32_t reported_drops[TELEMETRY_QUEUE_COUNT];  /* monitor thread only */
+
+static const char *const queue_names[TELEMETRY_QUEUE_COUNT] = {
+    [TELEMETRY_QUEUE_SENSOR]  = "sensor",
+    [TELEMETRY_QUEUE_UPTIME]  = "uptime",
+    [TELEMETRY_QUEUE_TRIGGER] = "trigger",
+    [TELEMETRY_QUEUE_POOL]    = "pool",
+    [TELEMETRY_QUEUE_OUTPUT]  = "output",
+    [TELEMETRY_QUEUE_STORE]   = "store",
+    [TELEMETRY_QUEUE_NET]     = "net",
+    [TELEMETRY_QUEUE_HOST]    = "host",
+};
+
+const char *queue_stats_name(enum telemetry_queue queue)
+{
+    return queue_names[queue];
+}
+
+void queue_stats_report(void)
+{
+    printk(" | queues depth/high/drops");
+    for (int q = 0; q < TELEMETRY_QUEUE_COUNT; q++) {
+        printk(" %s %u/%u/%u", queue_names[q], queue_stats_current_depth(q), queue_stats_high_water(q),
+               queue_stats_drops(q));
+    }
+}
+
+void queue_stats_warn(void)
+{
+    for (int q = 0; q < TELEMETRY_QUEUE_COUNT; q++) {
+        uint32_t drops = queue_stats_drops(q);
+        uint32_t new_drops = drops - reported_drops[q];
+
+        /* At most one warning per queue and interval, however many drops happened in it */
+        if (CONFIG_TELEMETRY_QUEUE_DROP_WARN_THRESHOLD > 0 &&
+            new_drops >= CONFIG_TELEMETRY_QUEUE_DROP_WARN_THRESHOLD) {
+            LOG_WRN("%s queue dropped %u since last status", queue_names[q], new_drops);
+        }
+        reported_drops[q] = drops;
+    }
+}
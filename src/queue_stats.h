@@ -0,0 +1,77 @@
+#ifndef QUEUE_STATS_H_
+#define QUEUE_STATS_H_
+
+#include <stdint.h>
+#include <zephyr/sys/atomic.h>
+
+/*
+ * Per-queue accounting for every bounded hand-over point of the data path: drops, the depth seen
+ * by the last put and the high-water mark of that depth since boot.
+ * Counters are atomics so they can be bumped from any context and read at any time. Drop sites
+ * do not log; the monitor thread reports all queues once per STATUS interval (queue_stats_report()).
+ */
+
+enum telemetry_queue {
+    TELEMETRY_QUEUE_SENSOR,     /* producer -> aggregator sensor samples */
+    TELEMETRY_QUEUE_UPTIME,     /* producer -> aggregator uptime samples */
+    TELEMETRY_QUEUE_TRIGGER,    /* work handler -> producer triggers (workqueue trigger mode) */
+    TELEMETRY_QUEUE_POOL,       /* frames not built because the frame pool was exhausted */
+    TELEMETRY_QUEUE_OUTPUT,     /* aggregator -> output thread frames */
+    TELEMETRY_QUEUE_STORE,      /* aggregator -> flash log frames, including failed page writes */
+    TELEMETRY_QUEUE_NET,        /* aggregator -> UDP sender frames, including failed datagrams */
+    TELEMETRY_QUEUE_HOST,       /* aggregator -> host file writer frames (native_sim) */
+    TELEMETRY_QUEUE_COUNT,
+};
+
+extern atomic_t queue_drop_count[TELEMETRY_QUEUE_COUNT];
+extern atomic_t queue_depth[TELEMETRY_QUEUE_COUNT];
+extern atomic_t queue_high_water[TELEMETRY_QUEUE_COUNT];
+
+static inline void queue_stats_drop(enum telemetry_queue queue)
+{
+    atomic_inc(&queue_drop_count[queue]);
+}
+
+static inline void queue_stats_drop_many(enum telemetry_queue queue, uint32_t count)
+{
+    atomic_add(&queue_drop_count[queue], (atomic_val_t)count);
+}
+
+static inline uint32_t queue_stats_drops(enum telemetry_queue queue)
+{
+    return (uint32_t)atomic_get(&queue_drop_count[queue]);
+}
+
+/* Records the depth of a queue, typically right after a put; raises the high-water mark if needed */
+static inline void queue_stats_depth(enum telemetry_queue queue, uint32_t depth)
+{
+    atomic_val_t high;
+
+    atomic_set(&queue_depth[queue], (atomic_val_t)depth);
+    do {
+        high = atomic_get(&queue_high_water[queue]);
+    } while ((uint32_t)high < depth && !atomic_cas(&queue_high_water[queue], high, (atomic_val_t)depth));
+}
+
+static inline uint32_t queue_stats_current_depth(enum telemetry_queue queue)
+{
+    return (uint32_t)atomic_get(&queue_depth[queue]);
+}
+
+static inline uint32_t queue_stats_high_water(enum telemetry_queue queue)
+{
+    return (uint32_t)atomic_get(&queue_high_water[queue]);
+}
+
+const char *queue_stats_name(enum telemetry_queue queue);
+
+/* Prints depth/high-water/drops of every queue, as part of the STATUS line */
+void queue_stats_report(void);
+
+/*
+ * Logs one warning per queue that dropped at least CONFIG_TELEMETRY_QUEUE_DROP_WARN_THRESHOLD
+ * samples or frames since the previous call. Monitor thread only, once per STATUS interval.
+ */
+void queue_stats_warn(void);
+
+#endif /* QUEUE_STATS_H_ */
@@ -0,0 +1,71 @@
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "rollup.h"
+
+/* Every span must be a multiple of the previous one so that buckets nest */
+static const uint32_t level_span_ms[TELEMETRY_ROLLUP_LEVELS] = { 1000, 10000, 60000 };
+static const char *const level_name[TELEMETRY_ROLLUP_LEVELS] = { "1s", "10s", "60s" };
+
+void rollup_init(struct rollup *rollup)
+{
+    *rollup = (struct rollup){0};
+}
+
+static void fold(struct telemetry_rollup *bucket, int64_t start, int32_t min, int32_t max,
+                 int64_t sum, uint32_t count)
+{
+    if (bucket->count == 0) {
+        bucket->start = start;
+        bucket->min = min;
+        bucket->max = max;
+    } else {
+        bucket->min = MIN(bucket->min, min);
+        bucket->max = MAX(bucket->max, max);
+    }
+    bucket->sum += sum;
+    bucket->count += count;
+}
+
+uint8_t rollup_add(struct rollup *rollup, int64_t timestamp, const struct telemetry_channel_stats *stats,
+                   uint16_t slots, struct telemetry_rollup closed[TELEMETRY_ROLLUP_LEVELS])
+{
+    uint8_t mask = 0;
+
+    /* Lower levels close first so their bucket is folded in before the next level is checked */
+    for (uint32_t level = 0; level < TELEMETRY_ROLLUP_LEVELS; level++) {
+        struct telemetry_rollup *bucket = &rollup->open[level];
+
+        if (bucket->count == 0 || timestamp - bucket->start < level_span_ms[level]) {
+            continue;
+        }
+
+        closed[level] = *bucket;
+        mask |= BIT(level);
+        if (level + 1 < TELEMETRY_ROLLUP_LEVELS) {
+            int64_t span = level_span_ms[level + 1];
+
+            fold(&rollup->open[level + 1], bucket->start - bucket->start % span,
+                 bucket->min, bucket->max, bucket->sum, bucket->count);
+        }
+        *bucket = (struct telemetry_rollup){0};
+    }
+
+    /* Frames without primary samples only advance time */
+    if (stats->avg >= 0) {
+        fold(&rollup->open[0], timestamp - timestamp % level_span_ms[0],
+             stats->min, stats->max, (int64_t)stats->avg * slots, slots);
+    }
+
+    return mask;
+}
+
+uint32_t rollup_span_ms(uint32_t level)
+{
+    return level_span_ms[level];
+}
+
+const char *rollup_level_name(uint32_t level)
+{
+    return level_name[level];
+}
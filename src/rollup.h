@@ -0,0 +1,37 @@
+#ifndef ROLLUP_H_
+#define ROLLUP_H_
+
+#include <stdint.h>
+
+#include "telemetry.h"
+
+/*
+ * Cascaded multi-resolution rollups of the primary channel.
+ *
+ * Buckets of every level are aligned to multiples of their span (1 s, 10 s, 60 s of uptime), so a
+ * closed bucket of one level folds into the open bucket of the next one. Each level keeps only its
+ * open bucket: min, max, sum and count, updated in O(1) per frame with no sample history.
+ * A bucket closes on the first frame that falls into a later bucket of its level.
+ */
+
+struct rollup {
+    struct telemetry_rollup open[TELEMETRY_ROLLUP_LEVELS];  /* count 0: nothing folded in yet */
+};
+
+void rollup_init(struct rollup *rollup);
+
+/*
+ * Advances the rollups to timestamp and folds one frame worth of primary channel statistics in:
+ * the window min/max and the window average weighted by the frame slots it covers.
+ * Buckets closed by this call are copied to closed[level]. Returns the mask of closed levels.
+ */
+uint8_t rollup_add(struct rollup *rollup, int64_t timestamp, const struct telemetry_channel_stats *stats,
+                   uint16_t slots, struct telemetry_rollup closed[TELEMETRY_ROLLUP_LEVELS]);
+
+/* Span of a level in milliseconds */
+uint32_t rollup_span_ms(uint32_t level);
+
+/* Short level name for output, "1s", "10s" or "60s" */
+const char *rollup_level_name(uint32_t level);
+
+#endif /* ROLLUP_H_ */
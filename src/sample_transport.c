@@ -0,0 +1,49 @@
+#include <zephyr/kernel.h>
+
+#include "sample_transport.h"
+#include "footprint.h"
+
+#if defined(CONFIG_TELEMETRY_TRANSPORT_SPSC) || defined(CONFIG_TELEMETRY_TRANSPORT_ZBUS)
+
+SPSC_RING_DEFINE(sensor_ring, struct sensor_data, SENSOR_RING_SIZE);
+SPSC_RING_DEFINE(uptime_ring, struct uptime_data, UPTIME_RING_SIZE);
+TELEMETRY_FOOTPRINT_DEFINE(sensor_ring, "sensor ring", SENSOR_RING_SIZE * sizeof(struct sensor_data));
+TELEMETRY_FOOTPRINT_DEFINE(uptime_ring, "uptime ring", UPTIME_RING_SIZE * sizeof(struct uptime_data));
+
+#if defined(CONFIG_TELEMETRY_TRANSPORT_ZBUS)
+
+bool sensor_ring_put_ok;
+bool uptime_ring_put_ok;
+
+/*
+ * Runs synchronously in the publisher's context with the channel locked, so the message can be
+ * read in place. Each channel has a single publisher, which keeps the rings single-producer and
+ * lets the publisher read the result right after zbus_chan_pub(). A full ring is counted by the
+ * publisher, so a summary counts all of its samples.
+ */
+static void sample_ring_listener_cb(const struct zbus_channel *chan)
+{
+    if (chan == &sensor_chan) {
+        sensor_ring_put_ok = spsc_ring_put(&sensor_ring, zbus_chan_const_msg(chan));
+    } else {
+        uptime_ring_put_ok = spsc_ring_put(&uptime_ring, zbus_chan_const_msg(chan));
+    }
+}
+
+ZBUS_LISTENER_DEFINE(sample_ring_listener, sample_ring_listener_cb);
+
+ZBUS_CHAN_DEFINE(sensor_chan, struct sensor_data, NULL, NULL,
+                 ZBUS_OBSERVERS(sample_ring_listener), ZBUS_MSG_INIT(0));
+ZBUS_CHAN_DEFINE(uptime_chan, struct uptime_data, NULL, NULL,
+                 ZBUS_OBSERVERS(sample_ring_listener), ZBUS_MSG_INIT(0));
+
+#endif /* CONFIG_TELEMETRY_TRANSPORT_ZBUS */
+
+#else
+
+K_MSGQ_DEFINE(sensor_msgq, sizeof(struct sensor_data), SENSOR_QUEUE_SIZE, __alignof__(struct sensor_data));
+K_MSGQ_DEFINE(uptime_msgq, sizeof(struct uptime_data), UPTIME_QUEUE_SIZE, __alignof__(struct uptime_data));
+TELEMETRY_FOOTPRINT_DEFINE(sensor_msgq, "sensor msgq", SENSOR_QUEUE_SIZE * sizeof(struct sensor_data));
+TELEMETRY_FOOTPRINT_DEFINE(uptime_msgq, "uptime msgq", UPTIME_QUEUE_SIZE * sizeof(struct uptime_data));
+
+#endif /* CONFIG_TELEMETRY_TRANSPORT_SPSC || CONFIG_TELEMETRY_TRANSPORT_ZBUS */
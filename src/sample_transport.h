@@ -0,0 +1,148 @@
+#ifndef SAMPLE_TRANSPORT_H_
+#define SAMPLE_TRANSPORT_H_
+
+#include <zephyr/kernel.h>
+#if defined(CONFIG_TELEMETRY_TRANSPORT_ZBUS)
+#include <zephyr/zbus/zbus.h>
+#endif
+
+#include "telemetry.h"
+#include "spsc_ring.h"
+
+/*
+ * Producer -> aggregator sample transport.
+ *
+ * CONFIG_TELEMETRY_TRANSPORT_MSGQ passes samples through kernel message queues,
+ * CONFIG_TELEMETRY_TRANSPORT_SPSC through lock-free SPSC rings. Both are bounded and never block:
+ * put returns false when the transport is full and drain copies out at most max samples.
+ * used returns the current depth, for queue_stats.
+ *
+ * CONFIG_TELEMETRY_TRANSPORT_ZBUS publishes samples on sensor_chan and uptime_chan. The
+ * transport's own listener copies each sample into the SPSC rings the aggregator drains, so
+ * other observers can attach to the channels while the aggregator side stays unchanged.
+ * The listener runs inside zbus_chan_pub(), so put reports whether it reached the ring, and the
+ * caller counts a drop, weighted by a summary's sample count, the same way for every transport.
+ */
+
+#define SENSOR_QUEUE_SIZE           CONFIG_TELEMETRY_SENSOR_QUEUE_SIZE
+#define UPTIME_QUEUE_SIZE           2
+
+/* Ring capacities must be powers of two */
+#define SENSOR_RING_SIZE            CONFIG_TELEMETRY_SENSOR_RING_SIZE
+#define UPTIME_RING_SIZE            2
+
+#if defined(CONFIG_TELEMETRY_TRANSPORT_SPSC) || defined(CONFIG_TELEMETRY_TRANSPORT_ZBUS)
+
+extern struct spsc_ring sensor_ring;
+extern struct spsc_ring uptime_ring;
+
+#define SENSOR_TRANSPORT_CAPACITY   SENSOR_RING_SIZE
+#define UPTIME_TRANSPORT_CAPACITY   UPTIME_RING_SIZE
+
+#if defined(CONFIG_TELEMETRY_TRANSPORT_ZBUS)
+
+ZBUS_CHAN_DECLARE(sensor_chan, uptime_chan);
+
+/* Written by the ring listener during the publisher's zbus_chan_pub(); one publisher per channel */
+extern bool sensor_ring_put_ok;
+extern bool uptime_ring_put_ok;
+
+static inline bool sensor_transport_put(const struct sensor_data *msg)
+{
+    sensor_ring_put_ok = false;
+    return zbus_chan_pub(&sensor_chan, msg, K_NO_WAIT) == 0 && sensor_ring_put_ok;
+}
+
+static inline bool uptime_transport_put(const struct uptime_data *msg)
+{
+    uptime_ring_put_ok = false;
+    return zbus_chan_pub(&uptime_chan, msg, K_NO_WAIT) == 0 && uptime_ring_put_ok;
+}
+
+#else
+
+static inline bool sensor_transport_put(const struct sensor_data *msg)
+{
+    return spsc_ring_put(&sensor_ring, msg);
+}
+
+static inline bool uptime_transport_put(const struct uptime_data *msg)
+{
+    return spsc_ring_put(&uptime_ring, msg);
+}
+
+#endif /* CONFIG_TELEMETRY_TRANSPORT_ZBUS */
+
+static inline uint32_t sensor_transport_drain(struct sensor_data *out, uint32_t max)
+{
+    return spsc_ring_drain(&sensor_ring, out, max);
+}
+
+static inline uint32_t sensor_transport_used(void)
+{
+    return spsc_ring_used(&sensor_ring);
+}
+
+static inline uint32_t uptime_transport_used(void)
+{
+    return spsc_ring_used(&uptime_ring);
+}
+
+static inline uint32_t uptime_transport_drain(struct uptime_data *out, uint32_t max)
+{
+    return spsc_ring_drain(&uptime_ring, out, max);
+}
+
+#else
+
+extern struct k_msgq sensor_msgq;
+extern struct k_msgq uptime_msgq;
+
+#define SENSOR_TRANSPORT_CAPACITY   SENSOR_QUEUE_SIZE
+#define UPTIME_TRANSPORT_CAPACITY   UPTIME_QUEUE_SIZE
+
+static inline bool sensor_transport_put(const struct sensor_data *msg)
+{
+    return k_msgq_put(&sensor_msgq, msg, K_NO_WAIT) == 0;
+}
+
+static inline uint32_t sensor_transport_drain(struct sensor_data *out, uint32_t max)
+{
+    uint32_t count = 0;
+
+    while (count < max && k_msgq_get(&sensor_msgq, &out[count], K_NO_WAIT) == 0) {
+        count++;
+    }
+
+    return count;
+}
+
+static inline uint32_t sensor_transport_used(void)
+{
+    return k_msgq_num_used_get(&sensor_msgq);
+}
+
+static inline uint32_t uptime_transport_used(void)
+{
+    return k_msgq_num_used_get(&uptime_msgq);
+}
+
+static inline bool uptime_transport_put(const struct uptime_data *msg)
+{
+    return k_msgq_put(&uptime_msgq, msg, K_NO_WAIT) == 0;
+}
+
+static inline uint32_t uptime_transport_drain(struct uptime_data *out, uint32_t max)
+{
+    uint32_t count = 0;
+
+    while (count < max && k_msgq_get(&uptime_msgq, &out[count], K_NO_WAIT) == 0) {
+        count++;
+    }
+
+    return count;
+}
+
+#endif /* CONFIG_TELEMETRY_TRANSPORT_SPSC || CONFIG_TELEMETRY_TRANSPORT_ZBUS */
+
+#endif /* SAMPLE_TRANSPORT_H_ */
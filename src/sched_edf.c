@@ -0,0 +1,209 @@
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/logging/log.h>
+
+#include "telemetry.h"
+#include "sched_edf.h"
+
+LOG_MODULE_DECLARE(telemetry);
+
+/* ========== Global Variables ========== */
+
+struct edf_thread {
+    struct k_thread *thread;
+    int fixed_priority;
+};
+
+struct edf_job {
+    uint32_t release;       /* k_cycle_get_32() time */
+    uint32_t deadline;
+    uint16_t skip;          /* sink frames already counted as missed whose edf_done() is still to come */
+    bool     open;
+};
+
+/* Under edf_lock, released from ISRs, the publisher and the owner thread */
+static struct k_spinlock edf_lock;
+static struct edf_job jobs[EDF_ACTIVITY_COUNT];
+
+static atomic_t job_count[EDF_ACTIVITY_COUNT];
+static atomic_t miss_count[EDF_ACTIVITY_COUNT];
+
+/* Written by the main thread before the threads start */
+static struct k_thread *activity_thread[EDF_ACTIVITY_COUNT];
+
+/* Main thread only */
+static struct edf_thread edf_threads[EDF_MAX_THREADS];
+static uint32_t edf_thread_count;
+static bool edf_mode = true;
+
+static const char *const activity_names[EDF_ACTIVITY_COUNT] = {
+    [EDF_FRAME]  = "frame",
+    [EDF_SENSOR] = "sensor",
+    [EDF_UPTIME] = "uptime",
+    [EDF_OUTPUT] = "output",
+    [EDF_STORE]  = "store",
+    [EDF_NET]    = "net",
+    [EDF_HOST]   = "host",
+};
+
+/* ========== Job Functions ========== */
+
+/* Sinks get one release per queued frame; every other activity coalesces releases into one wakeup */
+static inline bool activity_queued(enum edf_activity activity)
+{
+    return activity >= EDF_OUTPUT;
+}
+
+static void count_job(enum edf_activity activity, bool missed)
+{
+    atomic_inc(&job_count[activity]);
+    if (missed) {
+        atomic_inc(&miss_count[activity]);
+    }
+}
+
+/* Gives the thread the earliest deadline among its open jobs. Under edf_lock. */
+static void update_thread_deadline(struct k_thread *thread, uint32_t now)
+{
+    bool found = false;
+    int32_t earliest = 0;
+
+    for (int a = 0; a < EDF_ACTIVITY_COUNT; a++) {
+        if (activity_thread[a] != thread || !jobs[a].open) {
+            continue;
+        }
+        int32_t left = (int32_t)(jobs[a].deadline - now);
+
+        if (!found || left < earliest) {
+            earliest = left;
+            found = true;
+        }
+    }
+
+    if (found) {
+        k_thread_deadline_set(thread, MAX(earliest, 0));
+    }
+}
+
+/* ========== Public API ========== */
+
+void edf_release(enum edf_activity activity, uint32_t relative_ms)
+{
+    edf_release_at(activity, k_cycle_get_32(), relative_ms);
+}
+
+void edf_release_at(enum edf_activity activity, uint32_t release_cycles, uint32_t relative_ms)
+{
+    k_spinlock_key_t key = k_spin_lock(&edf_lock);
+    struct edf_job *job = &jobs[activity];
+    uint32_t now = k_cycle_get_32();
+
+    /*
+     * Still open at the next release: its deadline, at most one period, has passed. A job whose
+     * release is still ahead has not started yet and is only rescheduled.
+     */
+    if (job->open && (int32_t)(now - job->release) >= 0) {
+        count_job(activity, true);
+        if (activity_queued(activity)) {
+            job->skip++;
+        }
+    }
+    job->open = true;
+    job->release = release_cycles;
+    job->deadline = release_cycles + k_ms_to_cyc_ceil32(relative_ms);
+
+    if (activity_thread[activity] != NULL) {
+        update_thread_deadline(activity_thread[activity], now);
+    }
+    k_spin_unlock(&edf_lock, key);
+}
+
+void edf_done(enum edf_activity activity)
+{
+    k_spinlock_key_t key = k_spin_lock(&edf_lock);
+    struct edf_job *job = &jobs[activity];
+    uint32_t now = k_cycle_get_32();
+
+    if (job->skip > 0) {
+        job->skip--;
+    } else if (job->open) {
+        job->open = false;
+        count_job(activity, (int32_t)(now - job->deadline) > 0);
+        if (activity_thread[activity] != NULL) {
+            update_thread_deadline(activity_thread[activity], now);
+        }
+    }
+    k_spin_unlock(&edf_lock, key);
+}
+
+void edf_drop(enum edf_activity activity)
+{
+    k_spinlock_key_t key = k_spin_lock(&edf_lock);
+    struct edf_job *job = &jobs[activity];
+
+    /* The dropped frame is the oldest queued one, which is the oldest late one when there are any */
+    if (job->skip > 0) {
+        job->skip--;
+    } else if (job->open) {
+        job->open = false;
+        count_job(activity, true);
+    }
+    k_spin_unlock(&edf_lock, key);
+}
+
+void edf_register(struct k_thread *thread, int fixed_priority, uint32_t activities)
+{
+    if (edf_thread_count == EDF_MAX_THREADS) {
+        LOG_WRN("EDF thread table full");
+        return;
+    }
+
+    edf_threads[edf_thread_count].thread = thread;
+    edf_threads[edf_thread_count].fixed_priority = fixed_priority;
+    edf_thread_count++;
+
+    for (int a = 0; a < EDF_ACTIVITY_COUNT; a++) {
+        if ((activities & BIT(a)) != 0) {
+            activity_thread[a] = thread;
+        }
+    }
+
+    k_thread_priority_set(thread, edf_mode ? PRIO_EDF : fixed_priority);
+}
+
+void edf_set_enabled(bool enabled)
+{
+    edf_mode = enabled;
+    for (uint32_t i = 0; i < edf_thread_count; i++) {
+        k_thread_priority_set(edf_threads[i].thread, enabled ? PRIO_EDF : edf_threads[i].fixed_priority);
+    }
+
+    LOG_INF("Data path scheduling %s", enabled ? "EDF" : "fixed priority");
+}
+
+bool edf_enabled(void)
+{
+    return edf_mode;
+}
+
+uint32_t edf_jobs(enum edf_activity activity)
+{
+    return (uint32_t)atomic_get(&job_count[activity]);
+}
+
+uint32_t edf_misses(enum edf_activity activity)
+{
+    return (uint32_t)atomic_get(&miss_count[activity]);
+}
+
+void edf_report(void)
+{
+    printk(" | %s misses/jobs", edf_mode ? "edf" : "fixed");
+    for (int a = 0; a < EDF_ACTIVITY_COUNT; a++) {
+        if (edf_jobs(a) == 0) {
+            continue;
+        }
+        printk(" %s %u/%u", activity_names[a], edf_misses(a), edf_jobs(a));
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef SCHED_EDF_H_
+#define SCHED_EDF_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <zephyr/kernel.h>
+
+/*
+ * Earliest-deadline-first scheduling of the data path (CONFIG_TELEMETRY_EDF).
+ *
+ * The kernel's CONFIG_SCHED_DEADLINE only orders threads of equal static priority by deadline. In EDF
+ * mode the aggregator, the producer, the trace replay thread and the sinks therefore all run at
+ * PRIO_EDF. The load threads keep their own priorities. The fixed-priority baseline restores each
+ * thread's PRIO_* value, and the deadlines then have no effect.
+ *
+ * A job is released by whoever makes its thread ready: the timer callback of a periodic activity, the
+ * frame publisher for a sink, or the thread itself before it sleeps until its next release. The
+ * release sets the thread's deadline before the thread can be picked, so a woken thread never
+ * competes with the deadline of its previous job. A thread serving several activities carries the
+ * earliest deadline among its open jobs.
+ *
+ * Misses are measured from the release, so time spent ready but not running counts. An activity
+ * released again while its job is still open has missed, since every deadline is at most one period.
+ * Timer activities coalesce such releases into one wakeup, so the next edf_done() closes the newest
+ * job. Sinks get one frame per release and call edf_done() once per frame, so the done of the late
+ * frame is skipped instead. Both schedules count misses the same way.
+ */
+
+enum edf_activity {
+    EDF_FRAME,          /* aggregator, one frame period, released by the frame timer */
+    EDF_SENSOR,         /* producer or trace replay, one sensor tick */
+    EDF_UPTIME,         /* producer, one uptime period; the frame batch in low-power mode */
+    EDF_OUTPUT,         /* sinks, one frame period per frame, released by frame_pool_publish() */
+    EDF_STORE,
+    EDF_NET,
+    EDF_HOST,
+    EDF_ACTIVITY_COUNT,
+};
+
+#if defined(CONFIG_TELEMETRY_EDF)
+
+/* Number of threads whose priority the mode switch changes */
+#define EDF_MAX_THREADS             8
+
+/* Releases a job now, with its deadline relative_ms later. Any context, ISRs included. */
+void edf_release(enum edf_activity activity, uint32_t relative_ms);
+
+/*
+ * Releases a job at release_cycles (k_cycle_get_32() time, at most 2^31 cycles ahead), for a thread
+ * that sleeps until its own next release. Call it right before the sleep. Releasing again before
+ * release_cycles reschedules the job instead of counting a miss.
+ */
+void edf_release_at(enum edf_activity activity, uint32_t release_cycles, uint32_t relative_ms);
+
+/* Ends the job. Only the thread that owns the activity calls this, once per handled release. */
+void edf_done(enum edf_activity activity);
+
+/* A sink frame was dropped from the queue before its thread saw it. Publisher side. */
+void edf_drop(enum edf_activity activity);
+
+/*
+ * Records the fixed priority of a data path thread and the activities (BIT(EDF_*)) it serves, and
+ * applies the current mode. Before k_thread_start().
+ */
+void edf_register(struct k_thread *thread, int fixed_priority, uint32_t activities);
+
+/* Switches between EDF and the fixed-priority baseline. Main thread only. */
+void edf_set_enabled(bool enabled);
+bool edf_enabled(void);
+
+uint32_t edf_jobs(enum edf_activity activity);
+uint32_t edf_misses(enum edf_activity activity);
+
+/* Appends the mode and the misses/jobs of every active activity to the STATUS line. Monitor thread only. */
+void edf_report(void);
+
+#else
+
+static inline void edf_release(enum edf_activity activity, uint32_t relative_ms)
+{
+    ARG_UNUSED(activity);
+    ARG_UNUSED(relative_ms);
+}
+
+static inline void edf_release_at(enum edf_activity activity, uint32_t release_cycles, uint32_t relative_ms)
+{
+    ARG_UNUSED(activity);
+    ARG_UNUSED(release_cycles);
+    ARG_UNUSED(relative_ms);
+}
+
+static inline void edf_done(enum edf_activity activity)
+{
+    ARG_UNUSED(activity);
+}
+
+static inline void edf_drop(enum edf_activity activity)
+{
+    ARG_UNUSED(activity);
+}
+
+static inline void edf_register(struct k_thread *thread, int fixed_priority, uint32_t activities)
+{
+    ARG_UNUSED(thread);
+    ARG_UNUSED(fixed_priority);
+    ARG_UNUSED(activities);
+}
+
+#endif /* CONFIG_TELEMETRY_EDF */
+
+#endif /* SCHED_EDF_H_ */
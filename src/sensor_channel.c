@@ -0,0 +1,34 @@
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "sensor_channel.h"
+
+LOG_MODULE_DECLARE(telemetry);
+
+uint32_t telemetry_channel_count(void)
+{
+    static uint32_t count;
+
+    if (count == 0) {
+        int registered;
+
+        STRUCT_SECTION_COUNT(telemetry_channel, &registered);
+        if (registered > CONFIG_TELEMETRY_MAX_CHANNELS) {
+            LOG_ERR("%d channels registered, only the first %d are used",
+                    registered, CONFIG_TELEMETRY_MAX_CHANNELS);
+            registered = CONFIG_TELEMETRY_MAX_CHANNELS;
+        }
+        count = (uint32_t)registered;
+    }
+
+    return count;
+}
+
+const struct telemetry_channel *telemetry_channel_get(uint32_t index)
+{
+    const struct telemetry_channel *channel;
+
+    STRUCT_SECTION_GET(telemetry_channel, index, &channel);
+
+    return channel;
+}
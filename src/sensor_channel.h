@@ -0,0 +1,69 @@
+#ifndef SENSOR_CHANNEL_H_
+#define SENSOR_CHANNEL_H_
+
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/util.h>
+
+#include "telemetry.h"
+
+/*
+ * Statically defined sensor channel registry.
+ *
+ * Every channel is a const entry in the telemetry_channel iterable section, so adding a channel costs
+ * no thread, no queue and no registration code. The producer and the aggregator address channels by
+ * their index in the section and keep all per-channel runtime state in struct-of-arrays storage.
+ *
+ * Channel 0 is the primary channel: it feeds the single-sensor fields of struct telemetry_frame.
+ * The section is sorted by name, which is why primary and secondary channels use different prefixes.
+ */
+
+struct telemetry_channel;
+
+/* Returns the next sample of the channel; seq counts the samples taken from this channel */
+typedef int (*telemetry_channel_read_t)(const struct telemetry_channel *channel, uint32_t seq);
+
+struct telemetry_channel {
+    const char *name;
+    uint32_t rate_ms;       /* sample period, a multiple of SYNTHETIC_SENSOR_RATE_MS */
+    uint32_t window_ms;     /* sliding window used for avg/min/max */
+    uint32_t fresh_ms;      /* latest sample older than this marks the frame degraded */
+    telemetry_channel_read_t read;
+    uintptr_t user_data;
+    uint32_t flags;         /* TELEMETRY_CHANNEL_* */
+};
+
+/* read() does not depend on when it runs, so missed ticks may be sampled late in one batch (low-power mode) */
+#define TELEMETRY_CHANNEL_BATCH     BIT(0)
+
+#define Z_TELEMETRY_CHANNEL_DEFINE(_var, _name, _rate_ms, _window_ms, _fresh_ms, _read, _user_data, _flags) \
+    BUILD_ASSERT((_rate_ms) > 0 && ((_rate_ms) % SYNTHETIC_SENSOR_RATE_MS) == 0,                        \
+                 "Channel rate must be a multiple of the sensor tick");                                 \
+    static const STRUCT_SECTION_ITERABLE(telemetry_channel, _var) = {                                   \
+        .name = STRINGIFY(_name),                                                                       \
+        .rate_ms = (_rate_ms),                                                                          \
+        .window_ms = (_window_ms),                                                                      \
+        .fresh_ms = (_fresh_ms),                                                                        \
+        .read = (_read),                                                                                \
+        .user_data = (uintptr_t)(_user_data),                                                           \
+        .flags = (_flags),                                                                              \
+    }
+
+/* Defines the primary channel (index 0). Exactly one per application. */
+#define TELEMETRY_PRIMARY_CHANNEL_DEFINE(_name, _rate_ms, _window_ms, _fresh_ms, _read, _user_data, _flags) \
+    Z_TELEMETRY_CHANNEL_DEFINE(_CONCAT(telemetry_channel_0_, _name), _name,                             \
+                               _rate_ms, _window_ms, _fresh_ms, _read, _user_data, _flags)
+
+/* Defines a secondary channel. Secondary channels follow the primary one in name order. */
+#define TELEMETRY_CHANNEL_DEFINE(_name, _rate_ms, _window_ms, _fresh_ms, _read, _user_data, _flags)     \
+    Z_TELEMETRY_CHANNEL_DEFINE(_CONCAT(telemetry_channel_1_, _name), _name,                             \
+                               _rate_ms, _window_ms, _fresh_ms, _read, _user_data, _flags)
+
+/* Number of registered channels, capped at CONFIG_TELEMETRY_MAX_CHANNELS */
+uint32_t telemetry_channel_count(void);
+
+/* Returns the channel at the given index, index < telemetry_channel_count() */
+const struct telemetry_channel *telemetry_channel_get(uint32_t index);
+
+#endif /* SENSOR_CHANNEL_H_ */
@@ -0,0 +1,15 @@
+#include "sine_lut.h"
+
+/* round(32767 * sin(2 * pi * i / SINE_LUT_STEPS)) for i = 0 .. SINE_LUT_STEPS - 1 */
+const int16_t sine_lut_q15[SINE_LUT_STEPS] = {
+         0,   2057,   4107,   6140,   8149,  10126,  12062,  13952,  15786,  17557,
+     19260,  20886,  22431,  23886,  25247,  26509,  27666,  28714,  29648,  30466,
+     31163,  31738,  32187,  32509,  32702,  32767,  32702,  32509,  32187,  31738,
+     31163,  30466,  29648,  28714,  27666,  26509,  25247,  23886,  22431,  20886,
+     19260,  17557,  15786,  13952,  12062,  10126,   8149,   6140,   4107,   2057,
+         0,  -2057,  -4107,  -6140,  -8149, -10126, -12062, -13952, -15786, -17557,
+    -19260, -20886, -22431, -23886, -25247, -26509, -27666, -28714, -29648, -30466,
+    -31163, -31738, -32187, -32509, -32702, -32767, -32702, -32509, -32187, -31738,
+    -31163, -30466, -29648, -28714, -27666, -26509, -25247, -23886, -22431, -20886,
+    -19260, -17557, -15786, -13952, -12062, -10126,  -8149,  -6140,  -4107,  -2057,
+};
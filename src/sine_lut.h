@@ -0,0 +1,24 @@
+#ifndef SINE_LUT_H_
+#define SINE_LUT_H_
+
+#include <stdint.h>
+
+/*
+ * Integer-only sine for FPU-less targets.
+ *
+ * SINE_LUT_STEPS points of one sine period in Q15. The table is const data resolved at compile time,
+ * so looking up a sample costs one load and no floating point or libm code is linked.
+ */
+
+#define SINE_LUT_STEPS              100
+#define SINE_LUT_Q15_ONE            32768
+
+extern const int16_t sine_lut_q15[SINE_LUT_STEPS];
+
+/* Returns amplitude * sin(2 * pi * step / SINE_LUT_STEPS), truncated toward zero like an (int) cast */
+static inline int32_t sine_lut_scaled(uint32_t step, int32_t amplitude)
+{
+    return (amplitude * sine_lut_q15[step % SINE_LUT_STEPS]) / SINE_LUT_Q15_ONE;
+}
+
+#endif /* SINE_LUT_H_ */
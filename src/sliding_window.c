@@ -0,0 +1,230 @@
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "sliding_window.h"
+
+BUILD_ASSERT(IS_POWER_OF_TWO(SLIDING_WINDOW_CAPACITY), "SLIDING_WINDOW_CAPACITY must be a power of two");
+
+#define SLOT(seq) ((seq) & (SLIDING_WINDOW_CAPACITY - 1))
+
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+#define SLOT_WEIGHT_MAX             CONFIG_TELEMETRY_SENSOR_SUMMARY_MAX_SAMPLES
+#else
+#define SLOT_WEIGHT_MAX             1
+#endif
+
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+BUILD_ASSERT(SLIDING_WINDOW_CAPACITY * SLOT_WEIGHT_MAX <= UINT16_MAX, "histogram bins count in uint16_t");
+
+static inline uint32_t hist_bin(const struct sliding_window *win, int32_t value)
+{
+    int64_t bin = ((int64_t)value - win->hist_lo) / win->hist_width;
+
+    return (uint32_t)CLAMP(bin, 0, SLIDING_WINDOW_HIST_BINS - 1);
+}
+#endif
+
+/* Slot accessors; without summaries a slot is one sample and values[] is all there is */
+static inline int32_t slot_high(const struct sliding_window *win, uint32_t slot)
+{
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+    return win->highs[slot];
+#else
+    return win->values[slot];
+#endif
+}
+
+static inline int32_t slot_sum(const struct sliding_window *win, uint32_t slot)
+{
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+    return win->sums[slot];
+#else
+    return win->values[slot];
+#endif
+}
+
+static inline uint16_t slot_weight(const struct sliding_window *win, uint32_t slot)
+{
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+    return win->weights[slot];
+#else
+    ARG_UNUSED(win);
+    ARG_UNUSED(slot);
+    return 1;
+#endif
+}
+
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+/* Sum of squares and histogram weight of a slot, every sample of a summary placed at its mean */
+static void slot_stats(struct sliding_window *win, uint32_t slot, int sign)
+{
+    int64_t sum = slot_sum(win, slot);
+    uint16_t weight = slot_weight(win, slot);
+    uint32_t bin = hist_bin(win, (int32_t)(sum / weight));
+
+    if (sign > 0) {
+        win->sum_sq += sum * sum / weight;
+        win->hist[bin] += weight;
+    } else {
+        win->sum_sq -= sum * sum / weight;
+        win->hist[bin] -= weight;
+    }
+}
+#endif
+
+void sliding_window_init(struct sliding_window *win, int64_t window_us)
+{
+    *win = (struct sliding_window){0};
+    win->window_us = window_us;
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+    sliding_window_set_range(win, CONFIG_TELEMETRY_WINDOW_STATS_MIN, CONFIG_TELEMETRY_WINDOW_STATS_MAX);
+#endif
+}
+
+/*
+ * Removes the oldest sample. A sample is at the front of a deque only if it is still the
+ * current min/max, so eviction pops at most one entry from each deque.
+ */
+static void evict_oldest(struct sliding_window *win)
+{
+    uint32_t seq = win->head;
+
+    if (win->min_head != win->min_tail && win->min_dq[SLOT(win->min_head)] == seq) {
+        win->min_head++;
+    }
+    if (win->max_head != win->max_tail && win->max_dq[SLOT(win->max_head)] == seq) {
+        win->max_head++;
+    }
+
+    win->sum -= slot_sum(win, SLOT(seq));
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+    win->samples -= win->weights[SLOT(seq)];
+#endif
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+    slot_stats(win, SLOT(seq), -1);
+#endif
+    win->head++;
+}
+
+void sliding_window_expire(struct sliding_window *win, int64_t now)
+{
+    int64_t cutoff_time = now - win->window_us;
+
+    while (win->head != win->tail && win->timestamps[SLOT(win->head)] < cutoff_time) {
+        evict_oldest(win);
+    }
+}
+
+/* Appends one slot; low and high feed the min and max deques */
+static void push_slot(struct sliding_window *win, int32_t low, int32_t high, int32_t sum, uint16_t weight,
+                      int64_t timestamp)
+{
+    sliding_window_expire(win, timestamp);
+
+    /* Window sized too small for the sample rate: fall back to count-based eviction */
+    if (sliding_window_count(win) == SLIDING_WINDOW_CAPACITY) {
+        evict_oldest(win);
+    }
+
+    uint32_t seq = win->tail;
+
+    win->values[SLOT(seq)] = low;
+    win->timestamps[SLOT(seq)] = timestamp;
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+    win->highs[SLOT(seq)] = high;
+    win->sums[SLOT(seq)] = sum;
+    win->weights[SLOT(seq)] = weight;
+    win->samples += weight;
+#else
+    ARG_UNUSED(high);
+    ARG_UNUSED(weight);
+#endif
+    win->sum += sum;
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+    slot_stats(win, SLOT(seq), 1);
+#endif
+    win->tail++;
+
+    /* Drop every candidate the new sample dominates; it outlives all of them */
+    while (win->min_head != win->min_tail && win->values[SLOT(win->min_dq[SLOT(win->min_tail - 1)])] >= low) {
+        win->min_tail--;
+    }
+    win->min_dq[SLOT(win->min_tail++)] = seq;
+
+    while (win->max_head != win->max_tail && slot_high(win, SLOT(win->max_dq[SLOT(win->max_tail - 1)])) <= high) {
+        win->max_tail--;
+    }
+    win->max_dq[SLOT(win->max_tail++)] = seq;
+}
+
+void sliding_window_add(struct sliding_window *win, int32_t value, int64_t timestamp)
+{
+    push_slot(win, value, value, value, 1, timestamp);
+}
+
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+void sliding_window_add_summary(struct sliding_window *win, int32_t min, int32_t max, int32_t sum,
+                                uint16_t count, int64_t timestamp)
+{
+    push_slot(win, min, max, sum, MAX(count, 1), timestamp);
+}
+#endif
+
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+
+void sliding_window_set_range(struct sliding_window *win, int32_t lo, int32_t hi)
+{
+    int64_t span = MAX((int64_t)hi - lo + 1, 1);
+
+    win->hist_lo = lo;
+    win->hist_width = (int32_t)DIV_ROUND_UP(span, SLIDING_WINDOW_HIST_BINS);
+}
+
+static uint32_t isqrt64(uint64_t value)
+{
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t)root;
+}
+
+int32_t sliding_window_stddev(const struct sliding_window *win)
+{
+    int64_t n = sliding_window_samples(win);
+    int64_t spread = n * win->sum_sq - win->sum * win->sum;  /* n^2 * variance, never negative */
+
+    return (int32_t)isqrt64((uint64_t)MAX(spread, 0) / (uint64_t)(n * n));
+}
+
+int32_t sliding_window_quantile(const struct sliding_window *win, uint32_t pct)
+{
+    uint32_t count = sliding_window_samples(win);
+    uint32_t rank = MAX((count * pct + 99) / 100, 1U);
+    uint32_t below = 0;
+    uint32_t bin = 0;
+
+    while (bin < SLIDING_WINDOW_HIST_BINS - 1 && below + win->hist[bin] < rank) {
+        below += win->hist[bin++];
+    }
+
+    /* Place the rank evenly inside its bin, then clamp to the exact extremes */
+    int64_t edge = (int64_t)win->hist_lo + (int64_t)bin * win->hist_width;
+    int64_t value = edge + ((int64_t)win->hist_width * (2 * (rank - below) - 1)) / (2 * MAX(win->hist[bin], 1U));
+
+    return (int32_t)CLAMP(value, sliding_window_min(win), sliding_window_max(win));
+}
+
+#endif /* CONFIG_TELEMETRY_WINDOW_STATS */
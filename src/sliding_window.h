@@ -0,0 +1,137 @@
+#ifndef SLIDING_WINDOW_H_
+#define SLIDING_WINDOW_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Incremental time-based sliding window.
+ *
+ * Samples are evicted by timestamp (telemetry time in us) as new samples arrive (or when the window is queried), so the
+ * running sum and the monotonic min/max deques are always up to date. Every operation is O(1)
+ * amortized regardless of how many samples the window holds.
+ *
+ * With CONFIG_TELEMETRY_WINDOW_STATS the window also keeps the sum of squares and a fixed-bin
+ * histogram, both updated on add and evict. The variance is exact; quantiles are interpolated
+ * inside the histogram bin and clamped to the window min/max, at a cost of O(bins) per query.
+ *
+ * With CONFIG_TELEMETRY_SENSOR_SUMMARY a slot can also hold a summary of several samples (min, max,
+ * sum, count) that the producer folded under backpressure. The sum, the sample count and so the
+ * average stay exact, min and max too. The sum of squares and the histogram place every sample of
+ * a summary at its mean, so stddev and quantiles lose the spread inside a summary.
+ */
+
+/* Must be a power of two and at least the number of samples that can fall inside one window. */
+#define SLIDING_WINDOW_CAPACITY 32
+
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+#define SLIDING_WINDOW_HIST_BINS    CONFIG_TELEMETRY_WINDOW_STATS_BINS
+#endif
+
+struct sliding_window {
+    int32_t  values[SLIDING_WINDOW_CAPACITY];
+    int64_t  timestamps[SLIDING_WINDOW_CAPACITY];
+    uint32_t head;      /* sequence number of the oldest sample */
+    uint32_t tail;      /* sequence number of the next sample to be written */
+
+    /* Monotonic deques of sample sequence numbers: min_dq is non-decreasing, max_dq non-increasing */
+    uint32_t min_dq[SLIDING_WINDOW_CAPACITY];
+    uint32_t min_head;
+    uint32_t min_tail;
+    uint32_t max_dq[SLIDING_WINDOW_CAPACITY];
+    uint32_t max_head;
+    uint32_t max_tail;
+
+    int64_t  sum;
+    int64_t  window_us;
+
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+    int64_t  sum_sq;    /* exact while |value| < 2^26 */
+    int32_t  hist_lo;   /* lower edge of bin 0; values outside the range land in the edge bins */
+    int32_t  hist_width;
+    uint16_t hist[SLIDING_WINDOW_HIST_BINS];
+#endif
+
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+    /* values[] holds the minimum of a slot; a plain sample is a summary of weight 1 */
+    int32_t  highs[SLIDING_WINDOW_CAPACITY];
+    int32_t  sums[SLIDING_WINDOW_CAPACITY];
+    uint16_t weights[SLIDING_WINDOW_CAPACITY];
+    uint32_t samples;   /* sum of the weights of all slots */
+#endif
+};
+
+void sliding_window_init(struct sliding_window *win, int64_t window_us);
+
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+/* Sets the histogram range [lo, hi]. The window must be empty. */
+void sliding_window_set_range(struct sliding_window *win, int32_t lo, int32_t hi);
+
+/* Population standard deviation, rounded down */
+int32_t sliding_window_stddev(const struct sliding_window *win);
+
+/* Nearest-rank quantile estimate, pct in 1..100 */
+int32_t sliding_window_quantile(const struct sliding_window *win, uint32_t pct);
+#endif
+
+/* Adds a sample and evicts everything older than timestamp - window_us. */
+void sliding_window_add(struct sliding_window *win, int32_t value, int64_t timestamp);
+
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+/* Adds count samples summarized by min, max and sum as one slot stamped with the newest sample */
+void sliding_window_add_summary(struct sliding_window *win, int32_t min, int32_t max, int32_t sum,
+                                uint16_t count, int64_t timestamp);
+#endif
+
+/* Evicts everything older than now - window_us. Call before reading the statistics. */
+void sliding_window_expire(struct sliding_window *win, int64_t now);
+
+/*
+ * Changes the window length. Widening keeps every sample added from then on for longer;
+ * narrowing takes effect at the next add or expire.
+ */
+static inline void sliding_window_set_span(struct sliding_window *win, int64_t window_us)
+{
+    win->window_us = window_us;
+}
+
+/* Number of slots in the window */
+static inline uint32_t sliding_window_count(const struct sliding_window *win)
+{
+    return win->tail - win->head;
+}
+
+/* Number of samples in the window, counting every sample folded into a summary */
+static inline uint32_t sliding_window_samples(const struct sliding_window *win)
+{
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+    return win->samples;
+#else
+    return sliding_window_count(win);
+#endif
+}
+
+/* Statistics below are only meaningful when sliding_window_count() > 0 */
+
+static inline int32_t sliding_window_avg(const struct sliding_window *win)
+{
+    return (int32_t)(win->sum / (int64_t)sliding_window_samples(win));
+}
+
+static inline int32_t sliding_window_min(const struct sliding_window *win)
+{
+    return win->values[win->min_dq[win->min_head % SLIDING_WINDOW_CAPACITY] % SLIDING_WINDOW_CAPACITY];
+}
+
+static inline int32_t sliding_window_max(const struct sliding_window *win)
+{
+    uint32_t slot = win->max_dq[win->max_head % SLIDING_WINDOW_CAPACITY] % SLIDING_WINDOW_CAPACITY;
+
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+    return win->highs[slot];
+#else
+    return win->values[slot];
+#endif
+}
+
+#endif /* SLIDING_WINDOW_H_ */
@@ -0,0 +1,106 @@
+#ifndef SPSC_RING_H_
+#define SPSC_RING_H_
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#include "telemetry.h"
+
+/*
+ * Lock-free single-producer/single-consumer ring of fixed-size elements.
+ *
+ * head and tail are free-running indices: only the consumer writes head and only the producer writes
+ * tail, so neither side takes a lock or disables interrupts. The sequentially consistent atomic_get/
+ * atomic_set pair orders the element copy against the index update on both sides.
+ * The capacity must be a power of two. head, tail and the storage each start a cache line, so the
+ * producer's index store never invalidates the line the consumer polls on another CPU.
+ */
+
+struct spsc_ring {
+    uint8_t  *buffer;
+    uint32_t elem_size;
+    uint32_t mask;
+    atomic_t head __aligned(TELEMETRY_CACHE_LINE);  /* next element to read, written by the consumer only */
+    atomic_t tail __aligned(TELEMETRY_CACHE_LINE);  /* next element to write, written by the producer only */
+};
+
+#define SPSC_RING_DEFINE(name, type, capacity)                                              \
+    BUILD_ASSERT(IS_POWER_OF_TWO(capacity), "SPSC ring capacity must be a power of two");   \
+    static type _spsc_ring_storage_##name[capacity] __aligned(TELEMETRY_CACHE_LINE);        \
+    struct spsc_ring name = {                                                               \
+        .buffer = (uint8_t *)_spsc_ring_storage_##name,                                     \
+        .elem_size = sizeof(type),                                                          \
+        .mask = (capacity) - 1,                                                             \
+        .head = ATOMIC_INIT(0),                                                             \
+        .tail = ATOMIC_INIT(0),                                                             \
+    }
+
+static inline uint32_t spsc_ring_capacity(const struct spsc_ring *ring)
+{
+    return ring->mask + 1;
+}
+
+/* Number of elements currently queued. Exact from either side, a snapshot from anywhere else. */
+static inline uint32_t spsc_ring_used(struct spsc_ring *ring)
+{
+    return (uint32_t)atomic_get(&ring->tail) - (uint32_t)atomic_get(&ring->head);
+}
+
+/* Producer side. Returns false without copying when the ring is full. */
+static inline bool spsc_ring_put(struct spsc_ring *ring, const void *elem)
+{
+    uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+    uint32_t head = (uint32_t)atomic_get(&ring->head);
+
+    if (tail - head > ring->mask) {
+        return false;
+    }
+
+    memcpy(&ring->buffer[(tail & ring->mask) * ring->elem_size], elem, ring->elem_size);
+    atomic_set(&ring->tail, (atomic_val_t)(tail + 1));
+
+    return true;
+}
+
+/* Consumer side. Returns false when the ring is empty. */
+static inline bool spsc_ring_get(struct spsc_ring *ring, void *elem)
+{
+    uint32_t head = (uint32_t)atomic_get(&ring->head);
+    uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+
+    if (head == tail) {
+        return false;
+    }
+
+    memcpy(elem, &ring->buffer[(head & ring->mask) * ring->elem_size], ring->elem_size);
+    atomic_set(&ring->head, (atomic_val_t)(head + 1));
+
+    return true;
+}
+
+/*
+ * Consumer side bulk read. Copies up to max elements into out with at most two memcpy calls
+ * and publishes the new head once. Returns the number of elements copied.
+ */
+static inline uint32_t spsc_ring_drain(struct spsc_ring *ring, void *out, uint32_t max)
+{
+    uint32_t head = (uint32_t)atomic_get(&ring->head);
+    uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+    uint32_t count = MIN(tail - head, max);
+
+    if (count == 0) {
+        return 0;
+    }
+
+    uint32_t first = MIN(count, spsc_ring_capacity(ring) - (head & ring->mask));
+
+    memcpy(out, &ring->buffer[(head & ring->mask) * ring->elem_size], first * ring->elem_size);
+    memcpy((uint8_t *)out + first * ring->elem_size, ring->buffer, (count - first) * ring->elem_size);
+    atomic_set(&ring->head, (atomic_val_t)(head + count));
+
+    return count;
+}
+
+#endif /* SPSC_RING_H_ */
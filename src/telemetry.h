@@ -0,0 +1,119 @@
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ========== Data Structures ========== */
+
+/*
+ * Sample stamp carried by the transports. Compact records keep only the low 32 bits of the telemetry
+ * time (us); the aggregator widens them against its frame time, see sample_time_unpack().
+ */
+#if defined(CONFIG_TELEMETRY_COMPACT_SAMPLES)
+typedef uint32_t sample_time_t;
+#else
+typedef int64_t sample_time_t;
+#endif
+
+/* Alignment of data shared between CPUs, so writers on different CPUs never share a cache line */
+#if defined(CONFIG_DCACHE_LINE_SIZE) && (CONFIG_DCACHE_LINE_SIZE > 0)
+#define TELEMETRY_CACHE_LINE        CONFIG_DCACHE_LINE_SIZE
+#elif defined(CONFIG_SMP)
+#define TELEMETRY_CACHE_LINE        64  /* line size unknown, the common one of SMP parts */
+#else
+#define TELEMETRY_CACHE_LINE        8   /* no other CPU to share lines with, natural alignment only */
+#endif
+
+/* Per-channel frame statistics, -1 marks an invalid value */
+struct telemetry_channel_stats {
+    int32_t latest;
+    int32_t avg;
+    int32_t min;
+    int32_t max;
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+    int32_t stddev;     /* population standard deviation of the window */
+    int32_t p50;        /* histogram estimates, see sliding_window.h */
+    int32_t p95;
+#endif
+};
+
+#define TELEMETRY_ROLLUP_LEVELS     3  /* 1 s, 10 s and 60 s, see rollup.h */
+
+/* One closed rollup bucket of the primary channel; avg = sum / count */
+struct telemetry_rollup {
+    int64_t  start;     /* bucket start in ms since boot, a multiple of the level span */
+    int64_t  sum;       /* sum of frame window averages, each weighted by its frame slots */
+    int32_t  min;
+    int32_t  max;
+    uint32_t count;     /* frame slots folded in */
+};
+
+/*
+ * The single-sensor fields describe the primary channel (channel 0) and keep their meaning for
+ * consumers that only know one sensor; channels[] holds every registered channel including it.
+ * Fields are ordered by size, so the only padding is the tail of the small fields.
+ */
+struct telemetry_frame {
+    int64_t  timestamp;
+#if defined(CONFIG_TELEMETRY_ROLLUP)
+    struct telemetry_rollup rollups[TELEMETRY_ROLLUP_LEVELS];  /* valid where rollup_closed is set */
+#endif
+    uint32_t frame_id;
+    uint32_t uptime;
+    int      latest_sensor_value;
+    uint32_t sensor_avg_last_200ms;
+    int      sensor_min_last_200ms;
+    int      sensor_max_last_200ms;
+    uint16_t slot_count;        /* frame slots covered, more than one for merged catch-up frames */
+    uint8_t  channel_count;
+    bool     degraded;
+    bool     gap;               /* placeholder for slot_count missed slots starting at frame_id, carries no data */
+#if defined(CONFIG_TELEMETRY_ROLLUP)
+    uint8_t  rollup_closed;     /* mask of levels whose bucket closed with this frame */
+#endif
+    struct telemetry_channel_stats channels[CONFIG_TELEMETRY_MAX_CHANNELS];
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+    uint32_t sample_isr_cycles;     /* timer ISR stamp of the newest primary sample */
+    uint32_t assembled_cycles;      /* stamp taken when the aggregator finished the frame */
+#endif
+};
+
+/* 12 bytes with compact stamps and neither summaries nor latency stamps, 16 with 64-bit stamps */
+struct sensor_data {
+    sample_time_t timestamp_us;     /* telemetry time of the timer ISR that produced the sample, see telemetry_time.h */
+    int sensor_value;
+    uint16_t channel;   /* index in the channel registry */
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+    uint16_t count;     /* samples folded into the record, 1 for a plain sample; sensor_value is the newest */
+    int32_t  min;
+    int32_t  max;
+    int32_t  sum;
+#endif
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+    uint32_t isr_cycles;        /* sensor timer ISR stamp of the tick that produced the sample */
+    uint32_t enqueue_cycles;    /* stamp taken right before the producer enqueued the sample */
+#endif
+};
+
+struct uptime_data {
+    sample_time_t timestamp_us;     /* telemetry time of the uptime timer ISR */
+    uint32_t uptime;
+};
+
+/* ========== Constants ========== */
+
+#define TELEMETRY_FRAME_RATE_MS     CONFIG_TELEMETRY_FRAME_RATE_MS  /* default 5 Hz, adjustable at runtime (frame_rate.h) */
+#define SYNTHETIC_SENSOR_RATE_MS    CONFIG_TELEMETRY_SENSOR_RATE_MS /* default 20 Hz */
+#define UPTIME_RATE_MS              CONFIG_TELEMETRY_UPTIME_RATE_MS /* default 1 Hz */
+
+#define PRIO_AGGREGATOR             5  /* Lower number = higher priority. Aggregator has to be high priority to meet deadlines. */
+#define PRIO_PRODUCER               7
+#define PRIO_OUTPUT                 8  /* Deferred frame output, below the data path but above the load simulation */
+#define PRIO_STORE                  9  /* Flash writer of the persistent frame log */
+#define PRIO_NET                    9  /* UDP frame sink sender */
+#define PRIO_HOST_FILE              9  /* native_sim host file sink writer */
+#define PRIO_LOAD_SPIKE             10
+#define PRIO_EDF                    PRIO_AGGREGATOR  /* CONFIG_TELEMETRY_EDF: whole data path, ordered by deadline */
+
+#endif /* TELEMETRY_H_ */
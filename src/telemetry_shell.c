@@ -0,0 +1,268 @@
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include "telemetry.h"
+#include "frame_history.h"
+#include "frame_rate.h"
+#include "queue_stats.h"
+#include "sensor_channel.h"
+#include "latency_stats.h"
+#if defined(CONFIG_TELEMETRY_FRAME_STORE)
+#include "frame_store.h"
+#endif
+#if defined(CONFIG_TELEMETRY_REPLAY)
+#include "trace_replay.h"
+#endif
+
+/*
+ * Console commands for debugging a running unit (CONFIG_TELEMETRY_SHELL).
+ *
+ * Every command only reads snapshots: frames come from the seqlocked frame history, counters from
+ * atomics, and a new frame period is a request the aggregator picks up at its next wakeup. Nothing
+ * here takes a lock the data path could wait on.
+ */
+
+/* ========== Constants ========== */
+
+#define STORE_READ_DEFAULT          10  /* frames printed by "store read" without a count */
+
+/* ========== Global Variables ========== */
+
+static struct telemetry_frame shell_frame;  /* shell thread only, too large for the shell stack */
+static char shell_channel_name[16];         /* shell thread only, name of a channel this image lacks */
+#if defined(CONFIG_TELEMETRY_FRAME_STORE)
+static struct frame_store_iter shell_store_iter;    /* holds one flash page */
+#endif
+
+/* ========== Formatting Functions ========== */
+
+/* Stored frames may come from an image with more channels; those print as ch<index>, like frame_decode.py */
+static const char *channel_name(uint32_t ch)
+{
+    if (ch < telemetry_channel_count()) {
+        return telemetry_channel_get(ch)->name;
+    }
+
+    snprintk(shell_channel_name, sizeof(shell_channel_name), "ch%u", ch);
+    return shell_channel_name;
+}
+
+static void print_channel(const struct shell *sh, uint32_t ch, const struct telemetry_channel_stats *stats)
+{
+    shell_fprintf(sh, SHELL_NORMAL, " | %s=%d/%d/%d/%d", channel_name(ch),
+                  stats->latest, stats->avg, stats->min, stats->max);
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+    shell_fprintf(sh, SHELL_NORMAL, "/%d/%d/%d", stats->stddev, stats->p50, stats->p95);
+#endif
+}
+
+/* Same fields as the console stream, every channel as name=latest/avg/min/max */
+static void print_frame(const struct shell *sh, const struct telemetry_frame *frame)
+{
+    if (frame->gap) {
+        shell_print(sh, "GAP %u-%u | ts=%lld | slots=%u", frame->frame_id,
+                    frame->frame_id + frame->slot_count - 1, frame->timestamp, frame->slot_count);
+        return;
+    }
+
+    shell_fprintf(sh, SHELL_NORMAL, "FRAME %u | ts=%lld | up=%u | degraded=%d", frame->frame_id,
+                  frame->timestamp, frame->uptime, frame->degraded ? 1 : 0);
+    if (frame->slot_count > 1) {
+        shell_fprintf(sh, SHELL_NORMAL, " | slots=%u", frame->slot_count);
+    }
+    for (uint32_t ch = 0; ch < frame->channel_count; ch++) {
+        print_channel(sh, ch, &frame->channels[ch]);
+    }
+    shell_fprintf(sh, SHELL_NORMAL, "\n");
+}
+
+static int parse_u32(const struct shell *sh, const char *arg, uint32_t *value)
+{
+    int err = 0;
+    unsigned long parsed = shell_strtoul(arg, 10, &err);
+
+    if (err != 0 || parsed > UINT32_MAX) {
+        shell_error(sh, "Invalid number: %s", arg);
+        return -EINVAL;
+    }
+
+    *value = (uint32_t)parsed;
+    return 0;
+}
+
+/* ========== Commands ========== */
+
+/* Oldest first, like the stream; frames the aggregator overwrites while printing are skipped */
+static int cmd_last(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t count;
+
+    if (parse_u32(sh, argv[1], &count) != 0) {
+        return -EINVAL;
+    }
+
+    uint32_t written = frame_history_count();
+
+    count = MIN(count, MIN(written, (uint32_t)CONFIG_TELEMETRY_HISTORY_DEPTH));
+    for (uint32_t serial = written - count; serial < written; serial++) {
+        int rc = frame_history_get(serial, &shell_frame);
+
+        if (rc == -EAGAIN) {
+            shell_warn(sh, "frame %u busy, skipped", serial);
+        } else if (rc == 0) {
+            print_frame(sh, &shell_frame);
+        }
+    }
+
+    return 0;
+}
+
+static int cmd_stats(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t written = frame_history_count();
+
+    shell_print(sh, "frames %u, period %u ms (requested %u ms)", written, frame_rate_period_ms(),
+                frame_rate_requested_ms());
+    if (written == 0 || frame_history_get(written - 1, &shell_frame) != 0) {
+        return 0;
+    }
+
+    shell_print(sh, "newest frame %u, ts %lld ms, uptime %u s, %s", shell_frame.frame_id,
+                shell_frame.timestamp, shell_frame.uptime, shell_frame.degraded ? "degraded" : "ok");
+    if (!shell_frame.gap) {
+        for (uint32_t ch = 0; ch < shell_frame.channel_count; ch++) {
+            const struct telemetry_channel_stats *stats = &shell_frame.channels[ch];
+
+            shell_fprintf(sh, SHELL_NORMAL, "  %-8s latest %d avg %d min %d max %d", channel_name(ch),
+                          stats->latest, stats->avg, stats->min, stats->max);
+#if defined(CONFIG_TELEMETRY_WINDOW_STATS)
+            shell_fprintf(sh, SHELL_NORMAL, " sd %d p50 %d p95 %d", stats->stddev, stats->p50, stats->p95);
+#endif
+            shell_fprintf(sh, SHELL_NORMAL, "\n");
+        }
+    }
+
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+    struct latency_summary summary;
+
+    for (int stage = 0; stage < LATENCY_STAGE_COUNT; stage++) {
+        latency_summarize(stage, &summary);
+        if (summary.count > 0) {
+            shell_print(sh, "  %-20s p50/p99/max %u/%u/%u us", latency_stage_name(stage),
+                        summary.p50_us, summary.p99_us, summary.max_us);
+        }
+    }
+#endif
+
+    return 0;
+}
+
+static int cmd_rate(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t period_ms;
+
+    if (argc > 1) {
+        if (parse_u32(sh, argv[1], &period_ms) != 0) {
+            return -EINVAL;
+        }
+        if (frame_rate_set(period_ms) != 0) {
+            shell_error(sh, "Frame period must be %u..%u ms", FRAME_RATE_MIN_MS,
+                        CONFIG_TELEMETRY_FRAME_RATE_MAX_MS);
+            return -EINVAL;
+        }
+    }
+
+    /* A new request shows up as the period once the aggregator has woken up */
+    shell_print(sh, "period %u ms, requested %u ms", frame_rate_period_ms(), frame_rate_requested_ms());
+    return 0;
+}
+
+static int cmd_queues(const struct shell *sh, size_t argc, char **argv)
+{
+    shell_print(sh, "%-8s %6s %6s %8s", "queue", "depth", "high", "drops");
+    for (int q = 0; q < TELEMETRY_QUEUE_COUNT; q++) {
+        shell_print(sh, "%-8s %6u %6u %8u", queue_stats_name(q), queue_stats_current_depth(q),
+                    queue_stats_high_water(q), queue_stats_drops(q));
+    }
+
+    return 0;
+}
+
+#if defined(CONFIG_TELEMETRY_REPLAY)
+/* The replay thread reschedules the record it waits for; the STATUS line shows the new rate */
+static int cmd_replay(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t speed;
+
+    if (parse_u32(sh, argv[1], &speed) != 0) {
+        return -EINVAL;
+    }
+
+    trace_replay_set_speed(speed);
+    if (speed != 0) {
+        shell_print(sh, "replay speed x%u", speed);
+    } else {
+        shell_print(sh, "replay at max rate");
+    }
+    return 0;
+}
+#endif
+
+#if defined(CONFIG_TELEMETRY_FRAME_STORE)
+/* Frames still in the store's RAM page are not in flash yet; "store flush" writes them */
+static int cmd_store_read(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t from_id;
+    uint32_t count = STORE_READ_DEFAULT;
+
+    if (parse_u32(sh, argv[1], &from_id) != 0 || (argc > 2 && parse_u32(sh, argv[2], &count) != 0)) {
+        return -EINVAL;
+    }
+
+    frame_store_iter_init(&shell_store_iter, from_id);
+    for (uint32_t i = 0; i < count; i++) {
+        int rc = frame_store_iter_next(&shell_store_iter, &shell_frame);
+
+        if (rc == -ENOENT) {
+            break;
+        }
+        if (rc != 0) {
+            shell_warn(sh, "corrupt page skipped");
+            continue;
+        }
+        print_frame(sh, &shell_frame);
+    }
+
+    return 0;
+}
+
+static int cmd_store_flush(const struct shell *sh, size_t argc, char **argv)
+{
+    frame_store_flush();
+    shell_print(sh, "partial page flush requested");
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(store_cmds,
+    SHELL_CMD_ARG(read, NULL, "Print stored frames from <frame_id>: read <frame_id> [<n>]", cmd_store_read, 2, 1),
+    SHELL_CMD(flush, NULL, "Write the partial RAM page to flash, e.g. before a reset", cmd_store_flush),
+    SHELL_SUBCMD_SET_END
+);
+#endif
+
+SHELL_STATIC_SUBCMD_SET_CREATE(telemetry_cmds,
+    SHELL_CMD_ARG(last, NULL, "Print the last <n> frames from the history", cmd_last, 2, 0),
+    SHELL_CMD(stats, NULL, "Newest frame statistics", cmd_stats),
+    SHELL_CMD_ARG(rate, NULL, "Show the frame period, or request a new one: rate [<ms>]", cmd_rate, 1, 1),
+    SHELL_CMD(queues, NULL, "Depth, high-water mark and drops of every queue", cmd_queues),
+#if defined(CONFIG_TELEMETRY_REPLAY)
+    SHELL_CMD_ARG(replay, NULL, "Set the trace replay speed, 0 for max rate: replay <speed>", cmd_replay, 2, 0),
+#endif
+#if defined(CONFIG_TELEMETRY_FRAME_STORE)
+    SHELL_CMD(store, &store_cmds, "Flash frame log", NULL),
+#endif
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(telemetry, &telemetry_cmds, "Telemetry aggregator", NULL);
@@ -0,0 +1,51 @@
+#ifndef TELEMETRY_TIME_H_
+#define TELEMETRY_TIME_H_
+
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+#include "telemetry.h"
+
+/*
+ * Telemetry time base: microseconds since boot.
+ *
+ * Sample timestamps are taken in the timer ISR that produced the sample, not after the scheduling
+ * hops to the producer, and are carried through struct sensor_data. Freshness, the sliding windows
+ * and the frame deadline check all compare in this unit. It comes from the 64-bit cycle counter where
+ * the timer has one, and from the tick counter otherwise, so the resolution is the better of the
+ * two. Frames still carry millisecond timestamps.
+ */
+
+static inline int64_t telemetry_time_us(void)
+{
+#if defined(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)
+    return (int64_t)k_cyc_to_us_floor64(k_cycle_get_64());
+#else
+    return (int64_t)k_ticks_to_us_floor64(k_uptime_ticks());
+#endif
+}
+
+#define TELEMETRY_US_PER_MS         1000
+
+/* Stamp as carried in struct sensor_data and struct uptime_data */
+static inline sample_time_t sample_time_pack(int64_t us)
+{
+    return (sample_time_t)us;
+}
+
+/*
+ * Full telemetry time of a stamp taken within 2^31 us (35 minutes) of now_us, either side, so a
+ * sample stamped after now_us was read still widens correctly. Compact stamps are widened with
+ * wrapping 32-bit arithmetic, so the wrap of the low word never shows.
+ */
+static inline int64_t sample_time_unpack(sample_time_t stamp, int64_t now_us)
+{
+#if defined(CONFIG_TELEMETRY_COMPACT_SAMPLES)
+    return now_us - (int32_t)((uint32_t)now_us - stamp);
+#else
+    ARG_UNUSED(now_us);
+    return stamp;
+#endif
+}
+
+#endif /* TELEMETRY_TIME_H_ */
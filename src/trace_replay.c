@@ -0,0 +1,351 @@
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/logging/log.h>
+#if defined(CONFIG_TELEMETRY_REPLAY_SOURCE_PARTITION)
+#include <zephyr/storage/flash_map.h>
+#endif
+#if defined(CONFIG_TELEMETRY_REPLAY_SOURCE_HOST_FILE)
+#include "soc.h"
+#include "cmdline.h"    /* native_sim command line options */
+#include "trace_replay_native.h"
+#endif
+
+#include "trace_replay.h"
+#include "sample_transport.h"
+#include "sensor_channel.h"
+#include "telemetry_time.h"
+#include "queue_stats.h"
+#include "footprint.h"
+#include "cpu_affinity.h"
+#include "sched_edf.h"
+
+LOG_MODULE_DECLARE(telemetry);
+
+/* ========== Constants ========== */
+
+#define TRACE_REPLAY_STACK_SIZE     1024
+#define TRACE_CHUNK_RECORDS         32   /* records read from flash at a time */
+#define TRACE_FULL_POLL             K_TICKS(1)  /* max rate: re-check period of a full transport */
+
+/* ========== Global Variables ========== */
+
+K_THREAD_STACK_DEFINE(trace_replay_stack, TRACE_REPLAY_STACK_SIZE);
+struct k_thread trace_replay_thread;
+
+static atomic_t replay_speed = ATOMIC_INIT(CONFIG_TELEMETRY_REPLAY_SPEED);
+static atomic_t replay_samples;     /* samples handed to the transport, including dropped ones */
+
+static uint32_t trace_count;
+
+#if defined(CONFIG_TELEMETRY_REPLAY_SOURCE_PARTITION)
+static const struct flash_area *trace_area;
+static uint8_t trace_chunk[TRACE_CHUNK_RECORDS * TRACE_RECORD_SIZE];   /* replay thread only */
+TELEMETRY_FOOTPRINT_DEFINE(trace_chunk, "replay chunk", sizeof(trace_chunk));
+static uint32_t trace_chunk_first = UINT32_MAX;
+#else
+static const uint8_t *trace_data;
+static size_t trace_size;
+#endif
+
+#if defined(CONFIG_TELEMETRY_REPLAY_SOURCE_BLOB)
+/* Generated from CONFIG_TELEMETRY_REPLAY_BLOB_FILE at build time */
+static const uint8_t trace_blob[] __aligned(4) = {
+#include "trace_blob.inc"
+};
+#endif
+
+#if defined(CONFIG_TELEMETRY_REPLAY_SOURCE_HOST_FILE)
+static char *trace_path = CONFIG_TELEMETRY_REPLAY_HOST_FILE_PATH;
+#endif
+
+/* Monitor thread only */
+static uint32_t reported_samples;
+static int64_t reported_at;
+
+/* ========== Trace Access ========== */
+
+#if defined(CONFIG_TELEMETRY_REPLAY_SOURCE_PARTITION)
+
+static int open_trace(uint8_t *hdr)
+{
+    int rc = flash_area_open(FIXED_PARTITION_ID(replay_partition), &trace_area);
+
+    if (rc != 0) {
+        return rc;
+    }
+
+    rc = flash_area_read(trace_area, 0, hdr, TRACE_HDR_SIZE);
+    if (rc != 0) {
+        return rc;
+    }
+
+    trace_count = sys_get_le32(&hdr[4]);
+    return (size_t)trace_count * TRACE_RECORD_SIZE > trace_area->fa_size - TRACE_HDR_SIZE ? -EINVAL : 0;
+}
+
+/* Returns the record, reading the flash chunk that holds it when needed, or NULL on a read error */
+static const uint8_t *trace_record(uint32_t index)
+{
+    uint32_t first = index - index % TRACE_CHUNK_RECORDS;
+
+    if (first != trace_chunk_first) {
+        uint32_t count = MIN(TRACE_CHUNK_RECORDS, trace_count - first);
+
+        if (flash_area_read(trace_area, TRACE_HDR_SIZE + first * TRACE_RECORD_SIZE,
+                            trace_chunk, count * TRACE_RECORD_SIZE) != 0) {
+            return NULL;
+        }
+        trace_chunk_first = first;
+    }
+
+    return &trace_chunk[(index - first) * TRACE_RECORD_SIZE];
+}
+
+#else
+
+static int open_trace(uint8_t *hdr)
+{
+#if defined(CONFIG_TELEMETRY_REPLAY_SOURCE_BLOB)
+    trace_data = trace_blob;
+    trace_size = sizeof(trace_blob);
+#else
+    unsigned long size = 0;
+
+    trace_data = trace_replay_native_map(trace_path, &size);
+    trace_size = size;
+    if (trace_data == NULL) {
+        LOG_ERR("Cannot map trace %s", trace_path);
+        return -ENOENT;
+    }
+#endif
+
+    if (trace_size < TRACE_HDR_SIZE) {
+        return -EINVAL;
+    }
+
+    memcpy(hdr, trace_data, TRACE_HDR_SIZE);
+    trace_count = sys_get_le32(&hdr[4]);
+    return (size_t)trace_count * TRACE_RECORD_SIZE > trace_size - TRACE_HDR_SIZE ? -EINVAL : 0;
+}
+
+static const uint8_t *trace_record(uint32_t index)
+{
+    return &trace_data[TRACE_HDR_SIZE + (size_t)index * TRACE_RECORD_SIZE];
+}
+
+#endif /* CONFIG_TELEMETRY_REPLAY_SOURCE_PARTITION */
+
+/* ========== Replay Functions ========== */
+
+static inline int64_t uptime_us(void)
+{
+    return (int64_t)k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+/* Pushes one sample like the producer does, counting a full transport as a drop */
+static void replay_sample(struct sensor_data *msg)
+{
+    msg->timestamp_us = sample_time_pack(telemetry_time_us());
+#if defined(CONFIG_TELEMETRY_SENSOR_SUMMARY)
+    msg->count = 1;     /* replayed samples are never folded, max rate backs off instead */
+    msg->min = msg->sensor_value;
+    msg->max = msg->sensor_value;
+    msg->sum = msg->sensor_value;
+#endif
+#if defined(CONFIG_TELEMETRY_LATENCY_STATS)
+    msg->enqueue_cycles = k_cycle_get_32();
+    msg->isr_cycles = msg->enqueue_cycles;  /* no timer ISR behind a replayed sample */
+#endif
+    if (!sensor_transport_put(msg)) {
+        queue_stats_drop(TELEMETRY_QUEUE_SENSOR);
+    }
+    queue_stats_depth(TELEMETRY_QUEUE_SENSOR, sensor_transport_used());
+    atomic_inc(&replay_samples);
+}
+
+/* Picks up a speed set by trace_replay_set_speed(). Returns true when it changed. */
+static bool replay_speed_changed(uint32_t *speed)
+{
+    uint32_t requested = (uint32_t)atomic_get(&replay_speed);
+
+    if (requested == *speed) {
+        return false;
+    }
+    *speed = requested;
+    return true;
+}
+
+/*
+ * The replay thread is the only sensor transport producer while a trace plays. Each record is due at
+ * base_us + (offset - base_offset) / speed. A speed change rebases the schedule on the previous record
+ * and wakes the thread, which then reschedules the record it was waiting for; a trace restart rebases
+ * on the first record. Playback never jumps, and a record that is already late goes out at once.
+ */
+static void trace_replay_thread_func(void *arg1, void *arg2, void *arg3)
+{
+    ARG_UNUSED(arg1);
+    ARG_UNUSED(arg2);
+    ARG_UNUSED(arg3);
+
+    struct sensor_data msg = {0};
+    uint32_t channel_count = telemetry_channel_count();
+    uint32_t speed = (uint32_t)atomic_get(&replay_speed);
+    uint32_t index = 0;
+    uint32_t offset_ms;
+    uint32_t base_offset = 0;
+    int64_t base_us = uptime_us();
+    uint32_t last_offset = 0;       /* offset and push time of the previous record */
+    int64_t last_us = base_us;
+
+    LOG_INF("Trace replay started, %u records at speed %u", trace_count, speed);
+
+    while (1) {
+        if (index == trace_count) {
+            if (!IS_ENABLED(CONFIG_TELEMETRY_REPLAY_LOOP)) {
+                break;
+            }
+            index = 0;
+            base_offset = 0;
+            base_us = uptime_us();
+            last_offset = 0;
+            last_us = base_us;
+        }
+
+        const uint8_t *record = trace_record(index++);
+
+        if (record == NULL) {
+            LOG_ERR("Trace read failed at record %u", index - 1);
+            break;
+        }
+        offset_ms = sys_get_le32(&record[0]);
+        msg.channel = sys_get_le16(&record[4]);
+        msg.sensor_value = (int32_t)sys_get_le32(&record[6]);
+
+        if (msg.channel >= channel_count) {
+            continue;
+        }
+
+        if (replay_speed_changed(&speed)) {
+            base_offset = last_offset;
+            base_us = last_us;
+        }
+
+        bool released = false;
+
+        while (speed != 0) {
+            int64_t delay_us = MAX((int64_t)offset_ms - (int64_t)base_offset, 0) * 1000 / speed;
+            int64_t due_us = base_us + delay_us;
+            int64_t now_us = uptime_us();
+
+            if (now_us >= due_us) {
+                break;
+            }
+
+            /* The record's release is its due time, set before the sleep so the wakeup already carries it */
+            edf_release_at(EDF_SENSOR, k_cycle_get_32() + k_us_to_cyc_ceil32(due_us - now_us),
+                           SYNTHETIC_SENSOR_RATE_MS);
+            released = true;
+            k_sleep(K_TIMEOUT_ABS_US(due_us));
+
+            /* Woken early by a speed change: reschedule this record on the new speed */
+            if (replay_speed_changed(&speed)) {
+                base_offset = last_offset;
+                base_us = last_us;
+            }
+        }
+
+        if (speed == 0) {
+            /* Max rate: back off instead of dropping, so the sample rate shows what the aggregator sustains */
+            while (sensor_transport_used() >= SENSOR_TRANSPORT_CAPACITY) {
+                k_sleep(TRACE_FULL_POLL);
+            }
+        }
+        if (!released || speed == 0) {
+            edf_release(EDF_SENSOR, SYNTHETIC_SENSOR_RATE_MS);
+        }
+
+        replay_sample(&msg);
+        edf_done(EDF_SENSOR);
+        last_offset = offset_ms;
+        last_us = uptime_us();
+    }
+
+    LOG_INF("Trace replay finished");
+}
+
+/* ========== Public API ========== */
+
+#if defined(CONFIG_TELEMETRY_REPLAY_SOURCE_HOST_FILE)
+/* --replay_trace=<path> overrides CONFIG_TELEMETRY_REPLAY_HOST_FILE_PATH */
+static void trace_replay_add_options(void)
+{
+    static struct args_struct_t trace_replay_options[] = {
+        {
+            .option = "replay_trace",
+            .name = "path",
+            .type = 's',
+            .dest = (void *)&trace_path,
+            .descript = "Sensor trace replayed instead of the synthetic sensor data",
+        },
+        ARG_TABLE_ENDMARKER
+    };
+
+    native_add_command_line_opts(trace_replay_options);
+}
+
+NATIVE_TASK(trace_replay_add_options, PRE_BOOT_1, 10);
+#endif
+
+int trace_replay_init(void)
+{
+    uint8_t hdr[TRACE_HDR_SIZE];
+    int rc = open_trace(hdr);
+
+    if (rc == 0 && (memcmp(hdr, TRACE_MAGIC, 4) != 0 || trace_count == 0)) {
+        rc = -EINVAL;
+    }
+    if (rc != 0) {
+        LOG_ERR("No usable sensor trace (%d)", rc);
+        return rc;
+    }
+
+    reported_at = k_uptime_get();
+
+    k_thread_create(&trace_replay_thread, trace_replay_stack,
+                    K_THREAD_STACK_SIZEOF(trace_replay_stack),
+                    trace_replay_thread_func, NULL, NULL, NULL,
+                    PRIO_PRODUCER, 0, K_FOREVER);
+    k_thread_name_set(&trace_replay_thread, "replay");
+    edf_register(&trace_replay_thread, PRIO_PRODUCER, BIT(EDF_SENSOR));
+    cpu_affinity_register(&trace_replay_thread, CPU_ROLE_PRODUCER, 0);
+    k_thread_start(&trace_replay_thread);
+
+    return 0;
+}
+
+void trace_replay_set_speed(uint32_t speed)
+{
+    atomic_set(&replay_speed, (atomic_val_t)speed);
+    k_wakeup(&trace_replay_thread);
+}
+
+void trace_replay_report(void)
+{
+    uint32_t samples = (uint32_t)atomic_get(&replay_samples);
+    uint32_t speed = (uint32_t)atomic_get(&replay_speed);
+    int64_t now = k_uptime_get();
+    int64_t elapsed_ms = MAX(now - reported_at, 1);
+
+    if (speed != 0) {
+        printk(" | replay x%u", speed);
+    } else {
+        printk(" | replay max");
+    }
+    printk(" %u samples %u/s", samples, (uint32_t)((int64_t)(samples - reported_samples) * 1000 / elapsed_ms));
+    reported_samples = samples;
+    reported_at = now;
+}
@@ -0,0 +1,43 @@
+#ifndef TRACE_REPLAY_H_
+#define TRACE_REPLAY_H_
+
+#include <stdint.h>
+
+#include "telemetry.h"
+
+/*
+ * Sensor trace replay (CONFIG_TELEMETRY_REPLAY).
+ *
+ * A replay thread takes the place of the synthetic sensor timer: it streams the records of a recorded
+ * trace through the sensor transport, so the aggregator, its windows and every sink see them exactly
+ * like live samples. The producer keeps generating the uptime samples. The trace comes from a blob
+ * linked into the image, the replay_partition flash partition, or a memory-mapped host file on
+ * native_sim (--replay_trace=<path>).
+ *
+ * Trace format, all little endian:
+ *   header  8 bytes: magic "TRC1", record count
+ *   record 10 bytes: time offset from the start of the trace in ms, channel index (16 bit), value (32 bit signed)
+ * Records must be in time order. Records of a channel that is not registered are skipped.
+ *
+ * At speed N the offsets are divided by N. Speed 0 replays at the highest rate the aggregator sustains:
+ * the replay thread waits whenever the sensor transport is full instead of dropping, so the reported
+ * sample rate is the real throughput limit. scripts/trace_make.py builds traces from CSV.
+ */
+
+#define TRACE_MAGIC                 "TRC1"
+#define TRACE_HDR_SIZE              8
+#define TRACE_RECORD_SIZE           10
+
+/* Opens the trace and starts the replay thread. Returns 0 or a negative errno. */
+int trace_replay_init(void);
+
+/*
+ * Changes the playback speed, 0 for max rate. Takes effect at once: the record the replay thread waits
+ * for is rescheduled at the new speed, counted from the previous record.
+ */
+void trace_replay_set_speed(uint32_t speed);
+
+/* Appends the replayed sample count and rate since the previous call to the STATUS line. Monitor thread only. */
+void trace_replay_report(void);
+
+#endif /* TRACE_REPLAY_H_ */
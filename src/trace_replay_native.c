@@ -0,0 +1,33 @@
+/* Built with the host C library into the native_sim runner, see trace_replay_native.h */
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "trace_replay_native.h"
+
+const void *trace_replay_native_map(const char *path, unsigned long *size)
+{
+    struct stat st;
+    void *data;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+
+    data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  /* the mapping stays valid */
+    if (data == MAP_FAILED) {
+        return NULL;
+    }
+
+    *size = (unsigned long)st.st_size;
+    return data;
+}
@@ -0,0 +1,12 @@
+#ifndef TRACE_REPLAY_NATIVE_H_
+#define TRACE_REPLAY_NATIVE_H_
+
+/*
+ * Host side of the native_sim trace source. trace_replay_native.c is built into the native_sim runner
+ * against the host C library, so only plain C types cross this interface.
+ */
+
+/* Maps path read-only for the rest of the run. Returns the mapping and its size, or NULL. */
+const void *trace_replay_native_map(const char *path, unsigned long *size);
+
+#endif /* TRACE_REPLAY_NATIVE_H_ */